@@ -52,4 +52,11 @@ endif
 
 ifeq (${ENABLE_PMF},1)
 BL2_SOURCES		+=	lib/pmf/pmf_main.c
+endif
+
+ifeq (${IMAGE_DECOMPRESS_STREAM},1)
+include lib/zlib/zlib.mk
+
+BL2_SOURCES		+=	common/image_decompress.c		\
+				$(ZLIB_SOURCES)
 endif
\ No newline at end of file
@@ -13,11 +13,38 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/desc_image_load.h>
+#include <common/image_decompress.h>
 #include <drivers/auth/auth_mod.h>
 #include <plat/common/platform.h>
 
 #include <platform_def.h>
 
+/*******************************************************************************
+ * Load an image described by a load info node. Images marked with
+ * IMAGE_ATTRIB_DECOMPRESS_STREAM are decompressed while they are read, which
+ * is only possible for images which are not authenticated.
+ ******************************************************************************/
+static int bl2_load_image(const bl_load_info_node_t *node_info)
+{
+#if IMAGE_DECOMPRESS_STREAM
+	int err;
+
+	if ((node_info->image_info->h.attr &
+	    IMAGE_ATTRIB_DECOMPRESS_STREAM) != 0U) {
+		err = image_decompress_stream_load(node_info->image_id,
+						   node_info->image_info);
+		if (err != 0) {
+			return err;
+		}
+
+		return plat_mboot_measure_image(node_info->image_id,
+						node_info->image_info);
+	}
+#endif
+
+	return load_auth_image(node_info->image_id, node_info->image_info);
+}
+
 /*******************************************************************************
  * This function loads SCP_BL2/BL3x images and returns the ep_info for
  * the next executable image.
@@ -66,8 +93,7 @@ struct entry_point_info *bl2_load_images(void)
 		if ((bl2_node_info->image_info->h.attr &
 		    IMAGE_ATTRIB_SKIP_LOADING) == 0U) {
 			INFO("BL2: Loading image id %u\n", bl2_node_info->image_id);
-			err = load_auth_image(bl2_node_info->image_id,
-				bl2_node_info->image_info);
+			err = bl2_load_image(bl2_node_info);
 			if (err != 0) {
 				ERROR("BL2: Failed to load image id %u (%i)\n",
 				      bl2_node_info->image_id, err);
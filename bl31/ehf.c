@@ -16,6 +16,7 @@
 #include <context.h>
 #include <common/debug.h>
 #include <drivers/arm/gic_common.h>
+#include <lib/el3_profiler.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/cpu_data.h>
 #include <lib/el3_runtime/pubsub_events.h>
@@ -200,7 +201,9 @@ void ehf_deactivate_priority(unsigned int priority)
 
 	/*
 	 * Restore priority mask corresponding to the next priority, or the
-	 * one stashed earlier if there are no more to deactivate.
+	 * one stashed earlier if there are no more to deactivate. In the former
+	 * case the mask is unchanged, and the interrupt controller driver skips
+	 * the PMR update.
 	 */
 	cur_pri_idx = get_pe_highest_active_idx(pe_data);
 	if (cur_pri_idx == EHF_INVALID_IDX)
@@ -397,6 +400,7 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	uint32_t intr_raw;
 	unsigned int intr, pri, idx;
 	ehf_handler_t handler;
+	uint64_t start;
 
 	/*
 	 * Top-level interrupt type handler from Interrupt Management Framework
@@ -444,7 +448,9 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	 * Call registered handler. Pass the raw interrupt value to registered
 	 * handlers.
 	 */
+	start = el3_prof_now();
 	ret = handler(intr_raw, flags, handle, cookie);
+	el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_EHF, intr), start);
 
 	return (uint64_t) ret;
 }
@@ -17,6 +17,424 @@
 #include <common/debug.h>
 #include <common/fdt_wrappers.h>
 #include <common/uuid.h>
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
+
+/* Kinds of lookup that the index can answer */
+#define FDTW_KEY_NONE		U(0)
+#define FDTW_KEY_PROP		U(1)
+#define FDTW_KEY_SUBNODE	U(2)
+#define FDTW_KEY_COMPAT		U(3)
+#define FDTW_KEY_PHANDLE	U(4)
+
+#if FDT_WRAPPERS_INDEX_SIZE
+CASSERT(IS_POWER_OF_TWO(FDT_WRAPPERS_INDEX_SIZE),
+	assert_fdt_wrappers_index_size_power_of_two);
+
+/* Deepest node nesting that can be indexed */
+#define FDTW_INDEX_MAX_DEPTH	U(32)
+
+/*
+ * Open addressing hash table mapping a (kind, parent node, name) key to the
+ * offset of a property or node in the indexed DTB. Only the hash of the name
+ * is stored, so a hit is confirmed against the DTB itself. Since every
+ * property and node of the DTB is indexed, a miss means that the property or
+ * node does not exist.
+ */
+static struct fdtw_index_entry {
+	uint32_t hash;
+	int32_t parent;
+	int32_t offset;
+	uint32_t kind;
+} fdtw_index[FDT_WRAPPERS_INDEX_SIZE];
+
+static const void *fdtw_index_dtb;
+static unsigned int fdtw_index_used;
+
+static uint32_t fdtw_index_hash(unsigned int kind, int parent,
+				const char *name, int namelen)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U ^ kind ^ ((uint32_t)parent << 3);
+
+	for (int i = 0; i < namelen; i++) {
+		hash ^= (uint8_t)name[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/* Same matching rules as fdt_subnode_offset() */
+static bool fdtw_nodename_eq(const void *dtb, int node, const char *name,
+			     int namelen)
+{
+	const char *p;
+	int len;
+
+	p = fdt_get_name(dtb, node, &len);
+	if ((p == NULL) || (len < namelen) ||
+	    (memcmp(p, name, (size_t)namelen) != 0)) {
+		return false;
+	}
+
+	if (p[namelen] == '\0') {
+		return true;
+	}
+
+	return (memchr(name, '@', (size_t)namelen) == NULL) &&
+	       (p[namelen] == '@');
+}
+
+static bool fdtw_index_match(const void *dtb,
+			     const struct fdtw_index_entry *entry,
+			     const char *name, int namelen)
+{
+	const char *pname;
+
+	switch (entry->kind) {
+	case FDTW_KEY_PROP:
+		if (fdt_getprop_by_offset(dtb, entry->offset, &pname,
+					  NULL) == NULL) {
+			return false;
+		}
+		return (strlen(pname) == (size_t)namelen) &&
+		       (memcmp(pname, name, (size_t)namelen) == 0);
+	case FDTW_KEY_SUBNODE:
+		return fdtw_nodename_eq(dtb, entry->offset, name, namelen);
+	case FDTW_KEY_COMPAT:
+		/* Compatible strings are always NUL terminated */
+		return fdt_node_check_compatible(dtb, entry->offset,
+						 name) == 0;
+	case FDTW_KEY_PHANDLE:
+		return fdt_get_phandle(dtb, entry->offset) ==
+		       *(const uint32_t *)name;
+	default:
+		return false;
+	}
+}
+
+/*
+ * Look up a key in the index. Returns the offset stored for the key, or
+ * -FDT_ERR_NOTFOUND if the key is not in the index.
+ */
+static int fdtw_index_find(const void *dtb, unsigned int kind, int parent,
+			   const char *name, int namelen)
+{
+	uint32_t hash = fdtw_index_hash(kind, parent, name, namelen);
+	unsigned int mask = FDT_WRAPPERS_INDEX_SIZE - 1U;
+	unsigned int i = hash & mask;
+
+	while (fdtw_index[i].kind != FDTW_KEY_NONE) {
+		const struct fdtw_index_entry *entry = &fdtw_index[i];
+
+		if ((entry->hash == hash) && (entry->kind == kind) &&
+		    (entry->parent == parent) &&
+		    fdtw_index_match(dtb, entry, name, namelen)) {
+			return entry->offset;
+		}
+
+		i = (i + 1U) & mask;
+	}
+
+	return -FDT_ERR_NOTFOUND;
+}
+
+/*
+ * Add a key to the index, unless a matching key is already present. As the
+ * DTB is indexed in order, this keeps the first match, which is what the
+ * libfdt lookups return. Returns -1 if the index is too full.
+ */
+static int fdtw_index_add(const void *dtb, unsigned int kind, int parent,
+			  const char *name, int namelen, int offset)
+{
+	uint32_t hash = fdtw_index_hash(kind, parent, name, namelen);
+	unsigned int mask = FDT_WRAPPERS_INDEX_SIZE - 1U;
+	unsigned int i = hash & mask;
+
+	/* Keep a quarter of the slots free so that probe chains stay short */
+	if (fdtw_index_used >= (FDT_WRAPPERS_INDEX_SIZE / 4U) * 3U) {
+		return -1;
+	}
+
+	while (fdtw_index[i].kind != FDTW_KEY_NONE) {
+		const struct fdtw_index_entry *entry = &fdtw_index[i];
+
+		if ((entry->hash == hash) && (entry->kind == kind) &&
+		    (entry->parent == parent) &&
+		    fdtw_index_match(dtb, entry, name, namelen)) {
+			return 0;
+		}
+
+		i = (i + 1U) & mask;
+	}
+
+	fdtw_index[i].hash = hash;
+	fdtw_index[i].parent = parent;
+	fdtw_index[i].offset = offset;
+	fdtw_index[i].kind = kind;
+	fdtw_index_used++;
+
+	return 0;
+}
+
+static int fdtw_index_add_node(const void *dtb, int parent, int node)
+{
+	const char *name, *unit;
+	int len;
+
+	name = fdt_get_name(dtb, node, &len);
+	if (name == NULL) {
+		return -1;
+	}
+
+	if (fdtw_index_add(dtb, FDTW_KEY_SUBNODE, parent, name, len,
+			   node) != 0) {
+		return -1;
+	}
+
+	/* A node can also be looked up without its unit address */
+	unit = memchr(name, '@', (size_t)len);
+	if (unit != NULL) {
+		return fdtw_index_add(dtb, FDTW_KEY_SUBNODE, parent, name,
+				      (int)(unit - name), node);
+	}
+
+	return 0;
+}
+
+static int fdtw_index_add_props(const void *dtb, int node)
+{
+	const char *name, *str;
+	const void *value;
+	uint32_t phandle;
+	int prop, len, slen;
+
+	fdt_for_each_property_offset(prop, dtb, node) {
+		value = fdt_getprop_by_offset(dtb, prop, &name, &len);
+		if (value == NULL) {
+			return -1;
+		}
+
+		if (fdtw_index_add(dtb, FDTW_KEY_PROP, node, name,
+				   (int)strlen(name), prop) != 0) {
+			return -1;
+		}
+
+		if (strcmp(name, "compatible") == 0) {
+			for (str = value; str < ((const char *)value + len);
+			     str += slen + 1) {
+				slen = (int)strnlen(str, (size_t)
+						    ((const char *)value +
+						     len - str));
+				if (fdtw_index_add(dtb, FDTW_KEY_COMPAT, -1,
+						   str, slen, node) != 0) {
+					return -1;
+				}
+			}
+		} else if (((strcmp(name, "phandle") == 0) ||
+			    (strcmp(name, "linux,phandle") == 0)) &&
+			   (len == (int)sizeof(fdt32_t))) {
+			phandle = fdt32_to_cpu(*(const fdt32_t *)value);
+			if (fdtw_index_add(dtb, FDTW_KEY_PHANDLE, -1,
+					   (const char *)&phandle,
+					   (int)sizeof(phandle), node) != 0) {
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Walk a DTB once and index all of its properties, nodes, compatible strings
+ * and phandles, so that the fdtw_* lookup helpers do not need to scan the DTB.
+ * Any previous index is dropped. The DTB must not be modified, other than in
+ * place, until the index is dropped. Returns 0 on success, or -1 if the DTB
+ * does not fit in the index, in which case lookups scan the DTB as usual.
+ */
+int fdtw_index_build(const void *dtb)
+{
+	int parents[FDTW_INDEX_MAX_DEPTH];
+	int node, depth = -1;
+
+	assert(dtb != NULL);
+
+	fdtw_index_dtb = NULL;
+	fdtw_index_used = 0U;
+	(void)memset(fdtw_index, 0, sizeof(fdtw_index));
+
+	for (node = fdt_next_node(dtb, -1, &depth);
+	     (node >= 0) && (depth >= 0);
+	     node = fdt_next_node(dtb, node, &depth)) {
+		if (depth >= (int)FDTW_INDEX_MAX_DEPTH) {
+			break;
+		}
+
+		parents[depth] = node;
+
+		if ((depth > 0) &&
+		    (fdtw_index_add_node(dtb, parents[depth - 1], node) != 0)) {
+			break;
+		}
+
+		if (fdtw_index_add_props(dtb, node) != 0) {
+			break;
+		}
+	}
+
+	if (((node >= 0) && (depth >= 0)) ||
+	    ((node < 0) && (node != -FDT_ERR_NOTFOUND))) {
+		WARN("FDT: Device tree at %p does not fit in the index\n", dtb);
+		return -1;
+	}
+
+	fdtw_index_dtb = dtb;
+
+	VERBOSE("FDT: Indexed device tree at %p using %u of %u slots\n",
+		dtb, fdtw_index_used, FDT_WRAPPERS_INDEX_SIZE);
+
+	return 0;
+}
+
+/*
+ * Drop the index if it was built for the given DTB, before that DTB is
+ * modified or released.
+ */
+void fdtw_index_drop(const void *dtb)
+{
+	if (fdtw_index_dtb == dtb) {
+		fdtw_index_dtb = NULL;
+	}
+}
+
+static inline bool fdtw_indexed(const void *dtb)
+{
+	return (dtb != NULL) && (dtb == fdtw_index_dtb);
+}
+#else
+static inline bool fdtw_indexed(const void *dtb)
+{
+	return false;
+}
+
+static inline int fdtw_index_find(const void *dtb, unsigned int kind,
+				  int parent, const char *name, int namelen)
+{
+	return -FDT_ERR_NOTFOUND;
+}
+
+#endif /* FDT_WRAPPERS_INDEX_SIZE */
+
+/*
+ * Get the value of a property of a node, like fdt_getprop(), using the index
+ * of the DTB if there is one.
+ */
+const void *fdtw_getprop(const void *dtb, int node, const char *name,
+			 int *lenp)
+{
+	int prop;
+
+	if (!fdtw_indexed(dtb)) {
+		return fdt_getprop(dtb, node, name, lenp);
+	}
+
+	prop = fdtw_index_find(dtb, FDTW_KEY_PROP, node, name,
+			       (int)strlen(name));
+	if (prop < 0) {
+		if (lenp != NULL) {
+			*lenp = prop;
+		}
+		return NULL;
+	}
+
+	return fdt_getprop_by_offset(dtb, prop, NULL, lenp);
+}
+
+/*
+ * Find a subnode of a node by name, like fdt_subnode_offset(), using the index
+ * of the DTB if there is one.
+ */
+int fdtw_subnode_offset(const void *dtb, int parent, const char *name)
+{
+	if (!fdtw_indexed(dtb)) {
+		return fdt_subnode_offset(dtb, parent, name);
+	}
+
+	return fdtw_index_find(dtb, FDTW_KEY_SUBNODE, parent, name,
+			       (int)strlen(name));
+}
+
+/*
+ * Find a node by its full path, like fdt_path_offset(), using the index of
+ * the DTB if there is one. Aliases are resolved by libfdt.
+ */
+int fdtw_path_offset(const void *dtb, const char *path)
+{
+	const char *p = path, *q;
+	int node = 0;
+
+	if (!fdtw_indexed(dtb) || (*path != '/')) {
+		return fdt_path_offset(dtb, path);
+	}
+
+	while (*p != '\0') {
+		while (*p == '/') {
+			p++;
+		}
+
+		if (*p == '\0') {
+			break;
+		}
+
+		q = strchr(p, '/');
+		if (q == NULL) {
+			q = p + strlen(p);
+		}
+
+		node = fdtw_index_find(dtb, FDTW_KEY_SUBNODE, node, p,
+				       (int)(q - p));
+		if (node < 0) {
+			return node;
+		}
+
+		p = q;
+	}
+
+	return node;
+}
+
+/*
+ * Find the next node compatible with a string, like
+ * fdt_node_offset_by_compatible(). The index of the DTB, if there is one, is
+ * used to find the first compatible node.
+ */
+int fdtw_node_offset_by_compatible(const void *dtb, int startoffset,
+				   const char *compatible)
+{
+	if (!fdtw_indexed(dtb) || (startoffset >= 0)) {
+		return fdt_node_offset_by_compatible(dtb, startoffset,
+						     compatible);
+	}
+
+	return fdtw_index_find(dtb, FDTW_KEY_COMPAT, -1, compatible,
+			       (int)strlen(compatible));
+}
+
+/*
+ * Find a node by phandle, like fdt_node_offset_by_phandle(), using the index
+ * of the DTB if there is one.
+ */
+int fdtw_node_offset_by_phandle(const void *dtb, uint32_t phandle)
+{
+	if (!fdtw_indexed(dtb) || (phandle == 0U) || (phandle == ~0U)) {
+		return fdt_node_offset_by_phandle(dtb, phandle);
+	}
+
+	return fdtw_index_find(dtb, FDTW_KEY_PHANDLE, -1,
+			       (const char *)&phandle, (int)sizeof(phandle));
+}
 
 /*
  * Read cells from a given property of the given node. Any number of 32-bit
@@ -35,7 +453,7 @@ int fdt_read_uint32_array(const void *dtb, int node, const char *prop_name,
 	assert(node >= 0);
 
 	/* Access property and obtain its length (in bytes) */
-	prop = fdt_getprop(dtb, node, prop_name, &value_len);
+	prop = fdtw_getprop(dtb, node, prop_name, &value_len);
 	if (prop == NULL) {
 		VERBOSE("Couldn't find property %s in dtb\n", prop_name);
 		return -FDT_ERR_NOTFOUND;
@@ -105,8 +523,7 @@ int fdtw_read_bytes(const void *dtb, int node, const char *prop,
 	assert(node >= 0);
 
 	/* Access property and obtain its length (in bytes) */
-	ptr = fdt_getprop_namelen(dtb, node, prop, (int)strlen(prop),
-					&value_len);
+	ptr = fdtw_getprop(dtb, node, prop, &value_len);
 	if (ptr == NULL) {
 		WARN("Couldn't find property %s in dtb\n", prop);
 		return -1;
@@ -140,7 +557,7 @@ int fdtw_read_string(const void *dtb, int node, const char *prop,
 	assert(str != NULL);
 	assert(size > 0U);
 
-	ptr = fdt_getprop_namelen(dtb, node, prop, (int)strlen(prop), NULL);
+	ptr = fdtw_getprop(dtb, node, prop, NULL);
 	if (ptr == NULL) {
 		WARN("Couldn't find property %s in dtb\n", prop);
 		return -1;
@@ -293,7 +710,7 @@ int fdt_get_reg_props_by_index(const void *dtb, int node, int index,
 
 	cell = index * (ac + sc);
 
-	prop = fdt_getprop(dtb, node, "reg", &len);
+	prop = fdtw_getprop(dtb, node, "reg", &len);
 	if (prop == NULL) {
 		WARN("Couldn't find \"reg\" property in dtb\n");
 		return -FDT_ERR_NOTFOUND;
@@ -627,9 +1044,10 @@ int fdtw_find_or_add_subnode(void *fdt, int parentoffset, const char *name)
 {
 	int offset;
 
-	offset = fdt_subnode_offset(fdt, parentoffset, name);
+	offset = fdtw_subnode_offset(fdt, parentoffset, name);
 
 	if (offset == -FDT_ERR_NOTFOUND) {
+		fdtw_index_drop(fdt);
 		offset = fdt_add_subnode(fdt, parentoffset, name);
 	}
 
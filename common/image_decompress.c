@@ -5,18 +5,27 @@
  */
 
 #include <assert.h>
+#include <errno.h>
 #include <stdint.h>
 
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/image_decompress.h>
+#include <drivers/io/io_storage.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
 
 static uintptr_t decompressor_buf_base;
 static uint32_t decompressor_buf_size;
 static decompressor_t *decompressor;
 static struct image_info saved_image_info;
 
+/* Streaming mode keeps its own state, it may be used alongside the above */
+static uintptr_t stream_buf_base;
+static uint32_t stream_buf_size;
+static const stream_decompressor_t *stream_decompressor;
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *_decompressor)
 {
@@ -78,3 +87,116 @@ int image_decompress(struct image_info *info)
 
 	return 0;
 }
+
+void image_decompress_stream_init(uintptr_t buf_base, uint32_t buf_size,
+				  const stream_decompressor_t *_decompressor)
+{
+	assert(buf_size > IMAGE_DECOMPRESS_CHUNK_SIZE);
+
+	stream_buf_base = buf_base;
+	stream_buf_size = buf_size;
+	stream_decompressor = _decompressor;
+}
+
+/*
+ * Load a compressed image and decompress it to its final destination chunk by
+ * chunk, as it is read from the storage. Only the first
+ * IMAGE_DECOMPRESS_CHUNK_SIZE bytes of the temporary buffer hold compressed
+ * data, the rest of it is the workspace of the decompressor.
+ *
+ * The compressed image never exists as a whole in memory, so this loader
+ * cannot be used for images which are authenticated in their compressed form.
+ */
+int image_decompress_stream_load(unsigned int image_id,
+				 struct image_info *info)
+{
+	uintptr_t dev_handle;
+	uintptr_t image_handle;
+	uintptr_t image_spec;
+	uintptr_t image_base;
+	uintptr_t chunk_base, work_base;
+	size_t image_size, chunk_size, bytes_read;
+	uint32_t work_size;
+	int ret, io_result;
+
+	assert(stream_decompressor != NULL);
+
+	chunk_base = stream_buf_base;
+	work_base = stream_buf_base + IMAGE_DECOMPRESS_CHUNK_SIZE;
+	work_size = stream_buf_size - IMAGE_DECOMPRESS_CHUNK_SIZE;
+
+	io_result = plat_get_image_source(image_id, &dev_handle, &image_spec);
+	if (io_result != 0) {
+		WARN("Failed to obtain reference to image id=%u (%i)\n",
+		     image_id, io_result);
+		return io_result;
+	}
+
+	io_result = io_open(dev_handle, image_spec, &image_handle);
+	if (io_result != 0) {
+		WARN("Failed to access image id=%u (%i)\n",
+		     image_id, io_result);
+		return io_result;
+	}
+
+	io_result = io_size(image_handle, &image_size);
+	if ((io_result != 0) || (image_size == 0U)) {
+		WARN("Failed to determine the size of the image id=%u (%i)\n",
+		     image_id, io_result);
+		ret = (io_result != 0) ? io_result : -EIO;
+		goto exit;
+	}
+
+	INFO("Loading compressed image id=%u at address 0x%lx\n", image_id,
+	     info->image_base);
+
+	ret = stream_decompressor->init(info->image_base, info->image_max_size,
+					work_base, work_size);
+	if (ret != 0) {
+		goto exit;
+	}
+
+	while (image_size != 0U) {
+		chunk_size = MIN(image_size, (size_t)IMAGE_DECOMPRESS_CHUNK_SIZE);
+
+		io_result = io_read(image_handle, chunk_base, chunk_size,
+				    &bytes_read);
+		if ((io_result != 0) || (bytes_read < chunk_size)) {
+			WARN("Failed to load image id=%u (%i)\n", image_id,
+			     io_result);
+			ret = (io_result != 0) ? io_result : -EIO;
+			break;
+		}
+
+		ret = stream_decompressor->update(chunk_base, chunk_size);
+		if (ret != 0) {
+			break;
+		}
+
+		image_size -= chunk_size;
+	}
+
+	/* Always conclude the decompression to release its resources */
+	io_result = stream_decompressor->final(&image_base);
+	if (ret == 0) {
+		ret = io_result;
+	}
+
+	if (ret != 0) {
+		ERROR("Failed to decompress image (err=%d)\n", ret);
+		goto exit;
+	}
+
+	info->image_size = image_base - info->image_base;
+
+	flush_dcache_range(info->image_base, info->image_size);
+
+	INFO("Image id=%u loaded: 0x%lx - 0x%lx\n", image_id,
+	     info->image_base, image_base);
+
+exit:
+	(void)io_close(image_handle);
+	(void)io_dev_close(dev_handle);
+
+	return ret;
+}
@@ -23,17 +23,72 @@
 #endif
 
 
+/*
+ * Private helper function to check the response to a command posted by a
+ * previous user of the channel, which no one has looked at yet. The caller
+ * is not the CPU which posted the command, so an error is only reported and
+ * counted in the channel. The channel must be owned by the caller and freed by
+ * the SCP.
+ *
+ * The caller may be running with its data cache disabled, e.g. on the CPU_OFF
+ * path, so the counter is cleaned and invalidated around its update to keep
+ * memory up to date for all CPUs.
+ */
+static void scmi_check_posted_command(scmi_channel_t *ch)
+{
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+	unsigned int token = SCMI_MSG_GET_TOKEN(mbx_mem->msg_header);
+	int ret;
+
+	if ((token != SCMI_POSTED_TOKEN) &&
+	    (token != SCMI_POSTED_TOKEN_QUEUED_OK))
+		return;
+
+	SCMI_PAYLOAD_RET_VAL1(mbx_mem->payload, ret);
+	if ((ret != SCMI_E_SUCCESS) &&
+	    ((ret != SCMI_E_QUEUED) || (token != SCMI_POSTED_TOKEN_QUEUED_OK))) {
+		ERROR("SCMI posted command 0x%x return 0x%x unexpected\n",
+				mbx_mem->msg_header, ret);
+#if !HW_ASSISTED_COHERENCY
+		flush_dcache_range((uintptr_t)&ch->posted_errors,
+				   sizeof(ch->posted_errors));
+#endif
+		ch->posted_errors++;
+#if !HW_ASSISTED_COHERENCY
+		flush_dcache_range((uintptr_t)&ch->posted_errors,
+				   sizeof(ch->posted_errors));
+#endif
+	}
+
+	/* The response has been collected, don't check it again */
+	mbx_mem->msg_header = 0;
+}
+
 /*
  * Private helper function to get exclusive access to SCMI channel.
  */
 void scmi_get_channel(scmi_channel_t *ch)
 {
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+
 	assert(ch->lock);
 	scmi_lock_get(ch->lock);
 
-	/* Make sure any previous command has finished */
-	assert(SCMI_IS_CHANNEL_FREE(
-			((mailbox_mem_t *)(ch->info->scmi_mbx_mem))->status));
+	/*
+	 * A command posted without waiting for its response may still be
+	 * processed by the SCP. Wait for the channel to be free before reusing
+	 * the mailbox.
+	 */
+	while (!SCMI_IS_CHANNEL_FREE(mbx_mem->status))
+		;
+
+	/*
+	 * Ensure that any access to the SCMI payload area is done after
+	 * reading mailbox status.
+	 */
+	dmbsy();
+
+	scmi_check_posted_command(ch);
 }
 
 /*
@@ -71,6 +126,59 @@ void scmi_send_sync_command(scmi_channel_t *ch)
 	dmbld();
 }
 
+/*
+ * Private helper function to transfer ownership of channel from AP to SCP
+ * without waiting for the response. The channel lock is released on return
+ * and the next user of the channel waits in scmi_get_channel() for the SCP
+ * to free the mailbox, and checks the status of the posted command. The
+ * command must have been created with one of the SCMI_POSTED_TOKEN tokens.
+ */
+void scmi_send_posted_command(scmi_channel_t *ch)
+{
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+
+	SCMI_MARK_CHANNEL_BUSY(mbx_mem->status);
+
+	/*
+	 * Ensure that any write to the SCMI payload area is seen by SCP before
+	 * we write to the doorbell register.
+	 */
+	dmbst();
+
+	ch->info->ring_doorbell(ch->info);
+
+	/*
+	 * Ensure that the write to the doorbell register is ordered prior to
+	 * releasing the channel lock.
+	 */
+	dmbsy();
+
+	assert(ch->lock);
+	scmi_lock_release(ch->lock);
+}
+
+/*
+ * API to get the number of commands posted on the channel whose failure has
+ * been reported so far.
+ */
+unsigned int scmi_get_posted_errors(void *p)
+{
+	scmi_channel_t *ch = (scmi_channel_t *)p;
+	unsigned int errors;
+
+	validate_scmi_channel(ch);
+
+	scmi_get_channel(ch);
+#if !HW_ASSISTED_COHERENCY
+	flush_dcache_range((uintptr_t)&ch->posted_errors,
+			   sizeof(ch->posted_errors));
+#endif
+	errors = ch->posted_errors;
+	scmi_put_channel(ch);
+
+	return errors;
+}
+
 /*
  * Private helper function to release exclusive access to SCMI channel.
  */
@@ -169,6 +277,13 @@ void *scmi_init(scmi_channel_t *ch)
 
 	scmi_lock_init(ch->lock);
 
+	/*
+	 * Don't mistake whatever is left in the mailbox for the response to a
+	 * posted command.
+	 */
+	((mailbox_mem_t *)(ch->info->scmi_mbx_mem))->msg_header = 0;
+	ch->posted_errors = 0U;
+
 	ch->is_initialized = 1;
 
 	ret = scmi_proto_version(ch, SCMI_PWR_DMN_PROTO_ID, &version);
@@ -55,6 +55,15 @@
 #define SCMI_MSG_TOKEN_WIDTH		10
 #define SCMI_MSG_TOKEN_MASK		((1 << SCMI_MSG_TOKEN_WIDTH) - 1)
 
+/*
+ * Tokens of the commands posted without waiting for their response. The SCP
+ * echoes the token in the response header, which lets the next user of the
+ * channel recognise the response to a posted command and check its status.
+ * SCMI_E_QUEUED is an accepted status only for SCMI_POSTED_TOKEN_QUEUED_OK.
+ */
+#define SCMI_POSTED_TOKEN		0x200
+#define SCMI_POSTED_TOKEN_QUEUED_OK	0x201
+
 
 /* SCMI mailbox flags */
 #define SCMI_FLAG_RESP_POLL	0
@@ -144,6 +153,7 @@ typedef struct mailbox_mem {
 /* Private APIs for use within SCMI driver */
 void scmi_get_channel(scmi_channel_t *ch);
 void scmi_send_sync_command(scmi_channel_t *ch);
+void scmi_send_posted_command(scmi_channel_t *ch);
 void scmi_put_channel(scmi_channel_t *ch);
 
 static inline void validate_scmi_channel(scmi_channel_t *ch)
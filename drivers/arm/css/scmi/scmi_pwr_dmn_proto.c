@@ -53,6 +53,38 @@ int scmi_pwr_state_set(void *p, uint32_t domain_id,
 	return ret;
 }
 
+/*
+ * API to post a SCMI power domain power state request without waiting for
+ * the SCP response. The SCP acts on the request while the AP carries on with
+ * its power transition, and the status of the request is checked by the next
+ * user of the channel. `allow_queued` tells whether SCMI_E_QUEUED is an
+ * acceptable status in addition to SCMI_E_SUCCESS.
+ */
+void scmi_pwr_state_set_nowait(void *p, uint32_t domain_id,
+				uint32_t scmi_pwr_state, bool allow_queued)
+{
+	mailbox_mem_t *mbx_mem;
+	unsigned int token = allow_queued ? SCMI_POSTED_TOKEN_QUEUED_OK :
+					    SCMI_POSTED_TOKEN;
+	uint32_t pwr_state_set_msg_flag = SCMI_PWR_STATE_SET_FLAG_ASYNC;
+	scmi_channel_t *ch = (scmi_channel_t *)p;
+
+	validate_scmi_channel(ch);
+
+	scmi_get_channel(ch);
+
+	mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+	mbx_mem->msg_header = SCMI_MSG_CREATE(SCMI_PWR_DMN_PROTO_ID,
+			SCMI_PWR_STATE_SET_MSG, token);
+	mbx_mem->len = SCMI_PWR_STATE_SET_MSG_LEN;
+	mbx_mem->flags = SCMI_FLAG_RESP_POLL;
+	SCMI_PAYLOAD_ARG3(mbx_mem->payload, pwr_state_set_msg_flag,
+						domain_id, scmi_pwr_state);
+
+	/* The channel is released once the doorbell has been rung */
+	scmi_send_posted_command(ch);
+}
+
 /*
  * API to get the SCMI power domain power state.
  */
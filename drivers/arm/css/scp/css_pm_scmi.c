@@ -85,6 +85,28 @@ static uint32_t default_scmi_channel_id;
  */
 ARM_SCMI_INSTANTIATE_LOCK;
 
+/*
+ * Helper function to request a power domain state change to the SCP. When
+ * CSS_SCMI_POSTED_PWR_REQ is enabled the request is posted and the caller
+ * carries on with its power transition without waiting for the SCP response.
+ * The status of a posted request is then checked against `allow_queued` by
+ * the next user of the channel, and SCMI_E_SUCCESS is returned.
+ */
+static int css_scp_pwr_state_set(unsigned int channel_id,
+		unsigned int domain_id, uint32_t scmi_pwr_state,
+		bool allow_queued)
+{
+#if CSS_SCMI_POSTED_PWR_REQ
+	scmi_pwr_state_set_nowait(scmi_handles[channel_id], domain_id,
+		scmi_pwr_state, allow_queued);
+
+	return SCMI_E_SUCCESS;
+#else
+	return scmi_pwr_state_set(scmi_handles[channel_id],
+		domain_id, scmi_pwr_state);
+#endif
+}
+
 /*
  * Function to obtain the SCMI Domain ID and SCMI Channel number from the linear
  * core position. The SCMI Channel number is encoded in the upper 16 bits and
@@ -158,9 +180,8 @@ void css_scp_suspend(const struct psci_power_state *target_state)
 
 	css_scp_core_pos_to_scmi_channel(plat_my_core_pos(),
 			&domain_id, &channel_id);
-	ret = scmi_pwr_state_set(scmi_handles[channel_id],
-		domain_id, scmi_pwr_state);
-
+	ret = css_scp_pwr_state_set(channel_id, domain_id, scmi_pwr_state,
+			false);
 	if (ret != SCMI_E_SUCCESS) {
 		ERROR("SCMI set power state command return 0x%x unexpected\n",
 				ret);
@@ -200,8 +221,8 @@ void css_scp_off(const struct psci_power_state *target_state)
 
 	css_scp_core_pos_to_scmi_channel(plat_my_core_pos(),
 			&domain_id, &channel_id);
-	ret = scmi_pwr_state_set(scmi_handles[channel_id],
-		domain_id, scmi_pwr_state);
+	ret = css_scp_pwr_state_set(channel_id, domain_id, scmi_pwr_state,
+			true);
 	if (ret != SCMI_E_QUEUED && ret != SCMI_E_SUCCESS) {
 		ERROR("SCMI set power state command return 0x%x unexpected\n",
 				ret);
@@ -230,8 +251,8 @@ void css_scp_on(u_register_t mpidr)
 
 	css_scp_core_pos_to_scmi_channel(core_pos, &domain_id,
 			&channel_id);
-	ret = scmi_pwr_state_set(scmi_handles[channel_id],
-		domain_id, scmi_pwr_state);
+	ret = css_scp_pwr_state_set(channel_id, domain_id, scmi_pwr_state,
+			true);
 	if (ret != SCMI_E_QUEUED && ret != SCMI_E_SUCCESS) {
 		ERROR("SCMI set power state command return 0x%x unexpected\n",
 				ret);
@@ -535,6 +535,14 @@ unsigned int gicv2_set_pmr(unsigned int mask)
 
 	old_mask = gicc_read_pmr(driver_data->gicc_base);
 
+	/*
+	 * Nested priority activations often program the mask already in
+	 * place. Skip the barriers and the PMR write in that case.
+	 */
+	if (old_mask == mask) {
+		return old_mask;
+	}
+
 	/*
 	 * Order memory updates w.r.t. PMR write, and ensure they're visible
 	 * before potential out of band interrupt trigger because of PMR update.
@@ -1285,6 +1285,14 @@ unsigned int gicv3_set_pmr(unsigned int mask)
 
 	old_mask = (unsigned int)read_icc_pmr_el1();
 
+	/*
+	 * Nested priority activations often program the mask already in
+	 * place. Skip the barrier and the PMR write in that case.
+	 */
+	if (old_mask == mask) {
+		return old_mask;
+	}
+
 	/*
 	 * Order memory updates w.r.t. PMR write, and ensure they're visible
 	 * before potential out of band interrupt trigger because of PMR update.
@@ -51,6 +51,16 @@ static bool is_sd_cmd6_enabled(void)
 	return ((mmc_flags & MMC_FLAG_SD_CMD6) != 0U);
 }
 
+static bool is_hs200_enabled(void)
+{
+	return ((mmc_flags & MMC_FLAG_HS200) != 0U);
+}
+
+static bool is_busy_end_enabled(void)
+{
+	return ((mmc_flags & MMC_FLAG_BUSY_END) != 0U);
+}
+
 static int mmc_send_cmd(unsigned int idx, unsigned int arg,
 			unsigned int r_type, unsigned int *r_data)
 {
@@ -473,6 +483,58 @@ static int mmc_send_op_cond(void)
 	return -EIO;
 }
 
+static int mmc_switch_hs200(unsigned int clk, unsigned int bus_width)
+{
+	unsigned char device_type = mmc_ext_csd[CMD_EXTCSD_DEVICE_TYPE];
+	int ret;
+
+	if ((device_type & (EXTCSD_DEVICE_TYPE_HS200_1V8 |
+			    EXTCSD_DEVICE_TYPE_HS200_1V2)) == 0U) {
+		VERBOSE("HS200 not supported by the device\n");
+		return 0;
+	}
+
+	/* HS200 is a SDR mode on a 4 or 8 bits bus */
+	if ((bus_width != MMC_BUS_WIDTH_4) && (bus_width != MMC_BUS_WIDTH_8)) {
+		VERBOSE("HS200 not supported with bus width %u\n", bus_width);
+		return 0;
+	}
+
+	if (ops->execute_tuning == NULL) {
+		WARN("HS200 requested without tuning support\n");
+		return 0;
+	}
+
+	/*
+	 * The host has to move to the HS200 clock before checking the switch
+	 * status, so the polling of mmc_set_ext_csd() can't be used here.
+	 */
+	ret = mmc_send_cmd(MMC_CMD(6),
+			   EXTCSD_WRITE_BYTES |
+			   EXTCSD_CMD(CMD_EXTCSD_HS_TIMING) |
+			   EXTCSD_VALUE(EXTCSD_HS_TIMING_HS200) |
+			   EXTCSD_CMD_SET_NORMAL,
+			   MMC_RESPONSE_R1B, NULL);
+	if (ret != 0) {
+		return ret;
+	}
+
+	mmc_dev_info->max_bus_freq = MMC_HS200_MAX_FREQ;
+	ret = ops->set_ios(clk, bus_width);
+	if (ret != 0) {
+		return ret;
+	}
+
+	do {
+		ret = mmc_device_state();
+		if (ret < 0) {
+			return ret;
+		}
+	} while (ret != MMC_STATE_TRAN);
+
+	return ops->execute_tuning();
+}
+
 static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 {
 	int ret;
@@ -557,6 +619,11 @@ static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 		return ret;
 	}
 
+	if (is_hs200_enabled() &&
+	    (mmc_dev_info->mmc_dev_type == MMC_IS_EMMC)) {
+		return mmc_switch_hs200(clk, bus_width);
+	}
+
 	if (is_sd_cmd6_enabled() &&
 	    (mmc_dev_info->mmc_dev_type == MMC_IS_SD_HC)) {
 		/* Try to switch to High Speed Mode */
@@ -636,13 +703,18 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 		return 0;
 	}
 
-	/* Wait buffer empty */
-	do {
-		ret = mmc_device_state();
-		if (ret < 0) {
-			return 0;
-		}
-	} while ((ret != MMC_STATE_TRAN) && (ret != MMC_STATE_DATA));
+	/*
+	 * Wait buffer empty, unless the host already waited for the end of
+	 * the transfer in ops->read().
+	 */
+	if (!is_busy_end_enabled()) {
+		do {
+			ret = mmc_device_state();
+			if (ret < 0) {
+				return 0;
+			}
+		} while ((ret != MMC_STATE_TRAN) && (ret != MMC_STATE_DATA));
+	}
 
 	if (!is_cmd23_enabled() && (size > MMC_BLOCK_SIZE)) {
 		ret = mmc_send_cmd(MMC_CMD(12), 0, MMC_RESPONSE_R1B, NULL);
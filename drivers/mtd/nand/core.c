@@ -20,6 +20,25 @@
  */
 static struct nand_device nand_dev;
 
+/*
+ * Number of blocks whose bad block marker is cached. Markers of blocks beyond
+ * this limit are read from the device each time they are needed.
+ */
+#ifndef PLATFORM_MTD_BBT_MAX_BLOCKS
+#define PLATFORM_MTD_BBT_MAX_BLOCKS	U(4096)
+#endif
+
+#define BBT_WORD_BITS		32U
+#define BBT_NB_WORDS		((PLATFORM_MTD_BBT_MAX_BLOCKS + \
+				  BBT_WORD_BITS - 1U) / BBT_WORD_BITS)
+
+/*
+ * Bad block table, filled lazily: a block marker is read from the device the
+ * first time the block is accessed, then served from the table.
+ */
+static uint32_t bbt_checked[BBT_NB_WORDS];
+static uint32_t bbt_bad[BBT_NB_WORDS];
+
 #pragma weak plat_get_scratch_buffer
 void plat_get_scratch_buffer(void **buffer_addr, size_t *buf_size)
 {
@@ -32,6 +51,33 @@ void plat_get_scratch_buffer(void **buffer_addr, size_t *buf_size)
 	*buf_size = sizeof(scratch_buff);
 }
 
+static int nand_block_is_bad(unsigned int block)
+{
+	unsigned int word = block / BBT_WORD_BITS;
+	uint32_t mask = BIT_32(block % BBT_WORD_BITS);
+	int is_bad;
+
+	if (block >= PLATFORM_MTD_BBT_MAX_BLOCKS) {
+		return nand_dev.mtd_block_is_bad(block);
+	}
+
+	if ((bbt_checked[word] & mask) != 0U) {
+		return ((bbt_bad[word] & mask) != 0U) ? 1 : 0;
+	}
+
+	is_bad = nand_dev.mtd_block_is_bad(block);
+	if (is_bad < 0) {
+		return is_bad;
+	}
+
+	if (is_bad == 1) {
+		bbt_bad[word] |= mask;
+	}
+	bbt_checked[word] |= mask;
+
+	return is_bad;
+}
+
 int nand_read(unsigned int offset, uintptr_t buffer, size_t length,
 	      size_t *length_read)
 {
@@ -63,7 +109,7 @@ int nand_read(unsigned int offset, uintptr_t buffer, size_t length,
 	}
 
 	while (block <= end_block) {
-		is_bad = nand_dev.mtd_block_is_bad(block);
+		is_bad = nand_block_is_bad(block);
 		if (is_bad < 0) {
 			return is_bad;
 		}
@@ -83,8 +129,24 @@ int nand_read(unsigned int offset, uintptr_t buffer, size_t length,
 		}
 
 		for (page = page_start; page < nb_pages; page++) {
-			if ((start_offset != 0U) ||
-			    (length < nand_dev.page_size)) {
+			unsigned int nb_full_pages =
+				MIN(nb_pages - page,
+				    (unsigned int)(length / nand_dev.page_size));
+
+			if ((start_offset == 0U) && (nb_full_pages > 1U) &&
+			    (nand_dev.mtd_read_pages != NULL)) {
+				/* Let the device stream consecutive pages */
+				ret = nand_dev.mtd_read_pages(&nand_dev,
+						(block * nb_pages) + page,
+						nb_full_pages, buffer);
+				if (ret != 0) {
+					return ret;
+				}
+
+				bytes_read = nb_full_pages * nand_dev.page_size;
+				page += nb_full_pages - 1U;
+			} else if ((start_offset != 0U) ||
+				   (length < nand_dev.page_size)) {
 				ret = nand_dev.mtd_read_page(
 						&nand_dev,
 						(block * nb_pages) + page,
@@ -152,7 +214,7 @@ int nand_seek_bb(uintptr_t base, unsigned int offset, size_t *extra_offset)
 			return -EIO;
 		}
 
-		is_bad = nand_dev.mtd_block_is_bad(block);
+		is_bad = nand_block_is_bad(block);
 		if (is_bad < 0) {
 			return is_bad;
 		}
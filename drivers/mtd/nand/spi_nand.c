@@ -229,6 +229,77 @@ static int spi_nand_read_page(unsigned int page, unsigned int offset,
 	return 0;
 }
 
+/*
+ * Move the page loaded in the device cache to its data buffer and, unless this
+ * is the last page, start loading the next page in the cache.
+ */
+static int spi_nand_read_cache_seq(bool last)
+{
+	struct spi_mem_op op;
+
+	zeromem(&op, sizeof(struct spi_mem_op));
+	op.cmd.opcode = last ? SPI_NAND_OP_READ_CACHE_LAST :
+			       SPI_NAND_OP_READ_CACHE_SEQ;
+	op.cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+
+	return spi_mem_exec_op(&op);
+}
+
+/*
+ * Read consecutive pages of a block using the read cache sequential mode: the
+ * array load of the next page overlaps the transfer of the current one.
+ */
+static int spi_nand_mtd_read_pages(struct nand_device *nand, unsigned int page,
+				   unsigned int nb_pages, uintptr_t buffer)
+{
+	unsigned int i;
+	uint8_t status;
+	int ret;
+
+	ret = spi_nand_ecc_enable(true);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = spi_nand_load_page(page);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = spi_nand_wait_ready(&status);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (i = 0U; i < nb_pages; i++) {
+		ret = spi_nand_read_cache_seq(i == (nb_pages - 1U));
+		if (ret != 0) {
+			return ret;
+		}
+
+		ret = spi_nand_wait_ready(&status);
+		if (ret != 0) {
+			return ret;
+		}
+
+		/* ECC status reports the page moved to the data buffer */
+		if ((status & SPI_NAND_STATUS_ECC_UNCOR) != 0U) {
+			return -EBADMSG;
+		}
+
+		ret = spi_nand_read_from_cache(page + i, 0U,
+					       (uint8_t *)buffer,
+					       nand->page_size);
+		if (ret != 0) {
+			return ret;
+		}
+
+		buffer += nand->page_size;
+	}
+
+	return 0;
+}
+
 static int spi_nand_mtd_block_is_bad(unsigned int block)
 {
 	unsigned int nbpages_per_block = spinand_dev.nand_dev->block_size /
@@ -309,6 +380,10 @@ int spi_nand_init(unsigned long long *size, unsigned int *erase_size)
 		return ret;
 	}
 
+	if ((spinand_dev.flags & SPI_NAND_HAS_CACHE_SEQ) != 0U) {
+		spinand_dev.nand_dev->mtd_read_pages = spi_nand_mtd_read_pages;
+	}
+
 	VERBOSE("SPI_NAND Detected ID 0x%x\n", id[1]);
 
 	VERBOSE("Page size %u, Block size %u, size %llu\n",
@@ -139,6 +139,7 @@ static void discover_list_protocols(struct scmi_msg *msg)
 	};
 	const uint8_t *list = NULL;
 	unsigned int count = 0U;
+	uint32_t skip = 0U;
 
 	if (msg->in_size != sizeof(*a2p)) {
 		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
@@ -146,12 +147,13 @@ static void discover_list_protocols(struct scmi_msg *msg)
 	}
 
 	a2p = (void *)msg->in;
+	skip = a2p->skip;
 
 	list = plat_scmi_protocol_list(msg->agent_id);
 	count = count_protocols_in_list(list);
 
-	if (count > a2p->skip) {
-		count = MIN((uint32_t)(count - a2p->skip),
+	if (count > skip) {
+		count = MIN((uint32_t)(count - skip),
 			    (uint32_t)(msg->out_size - sizeof(p2a)));
 	} else {
 		count = 0U;
@@ -160,7 +162,7 @@ static void discover_list_protocols(struct scmi_msg *msg)
 	p2a.num_protocols = count;
 
 	memcpy(msg->out, &p2a, sizeof(p2a));
-	memcpy(msg->out + sizeof(p2a), list + a2p->skip, count);
+	memcpy(msg->out + sizeof(p2a), list + skip, count);
 	msg->out_size_out = sizeof(p2a) + round_up(count, sizeof(uint32_t));
 }
 
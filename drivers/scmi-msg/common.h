@@ -67,7 +67,9 @@ struct scmi_protocol_message_attributes_p2a {
  * @agent_id: SCMI agent ID, safely set from secure world
  * @protocol_id: SCMI protocol ID for the related message, set by caller agent
  * @message_id: SCMI message ID for the related message, set by caller agent
- * @in: Address of the incoming message payload copied in secure memory
+ * @in: Address of the incoming message payload copied in secure memory, or
+ *	of the payload in the trusted shared memory in which case it aliases
+ *	@out: handlers shall consume input arguments before writing the output
  * @in_size: Byte length of the incoming message payload, set by caller agent
  * @out: Address of of the output message payload message in non-secure memory
  * @out_size: Byte length of the provisionned output buffer
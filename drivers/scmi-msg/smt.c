@@ -11,6 +11,7 @@
 #include <drivers/scmi-msg.h>
 #include <drivers/scmi.h>
 #include <lib/cassert.h>
+#include <lib/el3_profiler.h>
 #include <lib/mmio.h>
 #include <lib/spinlock.h>
 #include <lib/utils.h>
@@ -68,15 +69,12 @@ CASSERT(SCMI_PLAYLOAD_MAX + sizeof(struct smt_header) <= SMT_BUF_SLOT_SIZE,
 static uint32_t fast_smc_payload[PLATFORM_CORE_COUNT][SCMI_PLAYLOAD_U32_MAX];
 static uint32_t interrupt_payload[PLATFORM_CORE_COUNT][SCMI_PLAYLOAD_U32_MAX];
 
-/* SMP protection on channel access */
-static struct spinlock smt_channels_lock;
-
 /* If channel is not busy, set busy and return true, otherwise return false */
 static bool channel_set_busy(struct scmi_msg_channel *chan)
 {
 	bool channel_is_busy;
 
-	spin_lock(&smt_channels_lock);
+	spin_lock(&chan->lock);
 
 	channel_is_busy = chan->busy;
 
@@ -84,7 +82,7 @@ static bool channel_set_busy(struct scmi_msg_channel *chan)
 		chan->busy = true;
 	}
 
-	spin_unlock(&smt_channels_lock);
+	spin_unlock(&chan->lock);
 
 	return !channel_is_busy;
 }
@@ -112,6 +110,7 @@ static void scmi_proccess_smt(unsigned int agent_id, uint32_t *payload_buf)
 	size_t in_payload_size;
 	uint32_t smt_status;
 	struct scmi_msg msg;
+	uint64_t start;
 	bool error = true;
 
 	chan = plat_scmi_get_channel(agent_id);
@@ -145,21 +144,29 @@ static void scmi_proccess_smt(unsigned int agent_id, uint32_t *payload_buf)
 
 	/* Fill message */
 	zeromem(&msg, sizeof(msg));
-	msg.in = (char *)payload_buf;
 	msg.in_size = in_payload_size;
 	msg.out = (char *)smt_hdr->payload;
 	msg.out_size = chan->shm_size - sizeof(*smt_hdr);
 
 	assert((msg.out != NULL) && (msg.out_size >= sizeof(int32_t)));
 
-	/* Here the payload is copied in secure memory */
-	memcpy(msg.in, smt_hdr->payload, in_payload_size);
+	if (chan->shm_trusted) {
+		/* Agent cannot alter the payload, process it in place */
+		msg.in = (char *)smt_hdr->payload;
+	} else {
+		/* Here the payload is copied in secure memory */
+		msg.in = (char *)payload_buf;
+		memcpy(msg.in, smt_hdr->payload, in_payload_size);
+	}
 
 	msg.protocol_id = SMT_HDR_PROT_ID(smt_hdr->message_header);
 	msg.message_id = SMT_HDR_MSG_ID(smt_hdr->message_header);
 	msg.agent_id = agent_id;
 
+	start = el3_prof_now();
 	scmi_process_message(&msg);
+	el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_SCMI, msg.protocol_id),
+			start);
 
 	/* Update message length with the length of the response message */
 	smt_hdr->length = msg.out_size_out + sizeof(smt_hdr->message_header);
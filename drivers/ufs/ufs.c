@@ -27,8 +27,12 @@
 
 #define MAX_PRDT_SIZE			0x40000		/* 256KB */
 
+/* Transfer length of each READ(10) command issued by a queued read */
+#define UFS_QUEUED_CMD_SIZE		(MAX_PRDT_SIZE * 16)	/* 4MB */
+
 static ufs_params_t ufs_params;
 static int nutrs;	/* Number of UTP Transfer Request Slots */
+static int nqslots;	/* Number of slots usable by queued reads */
 
 /*
  * ufs_uic_error_handler - UIC error interrupts handler
@@ -382,30 +386,29 @@ static int is_slot_available(void)
 	return 0;
 }
 
-static void get_utrd(utp_utrd_t *utrd)
+/*
+ * Lay out the command descriptor of a transfer request: Command UPIU at @ucd
+ * (aligned with 128 bytes), followed by the Response UPIU and the PRDT.
+ */
+static void setup_utrd(utp_utrd_t *utrd, uintptr_t header, uintptr_t ucd,
+		       int task_tag)
 {
-	uintptr_t base;
-	int result;
-	utrd_header_t *hd;
-
-	assert(utrd != NULL);
-	result = is_slot_available();
-	assert(result == 0);
-
 	/* clear utrd */
 	memset((void *)utrd, 0, sizeof(utp_utrd_t));
-	base = ufs_params.desc_base;
-	/* clear the descriptor */
-	memset((void *)base, 0, UFS_DESC_SIZE);
 
-	utrd->header = base;
-	utrd->task_tag = 1; /* We always use the first slot */
+	utrd->header = header;
+	utrd->task_tag = task_tag;
 	/* CDB address should be aligned with 128 bytes */
-	utrd->upiu = ALIGN_CDB(utrd->header + sizeof(utrd_header_t));
+	utrd->upiu = ALIGN_CDB(ucd);
 	utrd->resp_upiu = ALIGN_8(utrd->upiu + sizeof(cmd_upiu_t));
 	utrd->size_upiu = utrd->resp_upiu - utrd->upiu;
 	utrd->size_resp_upiu = ALIGN_8(sizeof(resp_upiu_t));
 	utrd->prdt = utrd->resp_upiu + utrd->size_resp_upiu;
+}
+
+static void init_utrd_header(utp_utrd_t *utrd)
+{
+	utrd_header_t *hd;
 
 	hd = (utrd_header_t *)utrd->header;
 	hd->ucdba = utrd->upiu & UINT32_MAX;
@@ -413,9 +416,48 @@ static void get_utrd(utp_utrd_t *utrd)
 	/* Both RUL and RUO is based on DWORD */
 	hd->rul = utrd->size_resp_upiu >> 2;
 	hd->ruo = utrd->size_upiu >> 2;
+}
+
+static void get_utrd(utp_utrd_t *utrd)
+{
+	uintptr_t base;
+	int result;
+
+	assert(utrd != NULL);
+	result = is_slot_available();
+	assert(result == 0);
+
+	base = ufs_params.desc_base;
+	/* clear the descriptor */
+	memset((void *)base, 0, UFS_DESC_SIZE);
+
+	/* We always use the first slot */
+	setup_utrd(utrd, base, base + sizeof(utrd_header_t), 1);
+	init_utrd_header(utrd);
 	(void)result;
 }
 
+/*
+ * Queued reads keep the UTRL (one 32-byte header per slot) in the first
+ * UFS_DESC_SIZE bytes of the descriptor area and give each slot its own
+ * UFS_DESC_SIZE command descriptor after it.
+ */
+static void get_queued_utrd(utp_utrd_t *utrd, int slot, bool clear)
+{
+	uintptr_t header, ucd;
+
+	assert((slot >= 0) && (slot < nqslots));
+
+	header = ufs_params.desc_base + slot * sizeof(utrd_header_t);
+	ucd = ufs_params.desc_base + (slot + 1) * UFS_DESC_SIZE;
+	setup_utrd(utrd, header, ucd, slot + 1);
+	if (clear) {
+		memset((void *)header, 0, sizeof(utrd_header_t));
+		memset((void *)ucd, 0, UFS_DESC_SIZE);
+		init_utrd_header(utrd);
+	}
+}
+
 /*
  * Prepare UTRD, Command UPIU, Response UPIU.
  */
@@ -519,7 +561,8 @@ static int ufs_prepare_cmd(utp_utrd_t *utrd, uint8_t op, uint8_t lun,
 	}
 
 	prdt_end = utrd->prdt + utrd->prdt_length * sizeof(prdt_t);
-	flush_dcache_range(utrd->header, prdt_end - utrd->header);
+	flush_dcache_range(utrd->header, sizeof(utrd_header_t));
+	flush_dcache_range(utrd->upiu, prdt_end - utrd->upiu);
 	return 0;
 }
 
@@ -593,12 +636,11 @@ static void ufs_prepare_nop_out(utp_utrd_t *utrd)
 	flush_dcache_range((uintptr_t)utrd->header, UFS_DESC_SIZE);
 }
 
-static void ufs_send_request(int task_tag)
+/* Ring the doorbell once for all the slots set in @slots */
+static void ufs_send_requests(uint32_t slots)
 {
 	unsigned int data;
-	int slot;
 
-	slot = task_tag - 1;
 	/* clear all interrupts */
 	mmio_write_32(ufs_params.reg_base + IS, ~0);
 
@@ -609,7 +651,12 @@ static void ufs_send_request(int task_tag)
 	       UTRIACR_IATOVAL(0xFF);
 	mmio_write_32(ufs_params.reg_base + UTRIACR, data);
 	/* send request */
-	mmio_setbits_32(ufs_params.reg_base + UTRLDBR, 1U << slot);
+	mmio_setbits_32(ufs_params.reg_base + UTRLDBR, slots);
+}
+
+static void ufs_send_request(int task_tag)
+{
+	ufs_send_requests(1U << (task_tag - 1));
 }
 
 static int ufs_check_resp(utp_utrd_t *utrd, int trans_type, unsigned int timeout_ms)
@@ -865,6 +912,143 @@ static int ufs_read_capacity(int lun, unsigned int *num, unsigned int *size)
 	return -ETIMEDOUT;
 }
 
+/* Wait until the controller has completed all the requests in @slots */
+static int ufs_wait_for_slots(uint32_t slots, unsigned int timeout_ms)
+{
+	int result;
+
+	while ((mmio_read_32(ufs_params.reg_base + UTRLDBR) & slots) != 0U) {
+		result = ufs_wait_for_int_status(UFS_INT_UTRCS, timeout_ms,
+						 false);
+		if (result != 0) {
+			return result;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Clear the requests in @slots that the controller still owns, so that their
+ * descriptors and buffers can be reused. Return the slots that had completed.
+ */
+static uint32_t ufs_clear_slots(uint32_t slots)
+{
+	uint32_t pending = mmio_read_32(ufs_params.reg_base + UTRLDBR) & slots;
+	unsigned int timeout_ms = CMD_TIMEOUT_MS;
+
+	/* A request is cleared by writing 0 to its bit */
+	mmio_write_32(ufs_params.reg_base + UTRLCLR, ~pending);
+
+	while ((mmio_read_32(ufs_params.reg_base + UTRLDBR) & pending) != 0U) {
+		if (timeout_ms-- == 0U) {
+			/* The controller may still write to the buffers */
+			ERROR("UFS: failed to clear requests 0x%x\n", pending);
+			panic();
+		}
+		mdelay(1);
+	}
+
+	return slots & ~pending;
+}
+
+/*
+ * Split a large read into UFS_QUEUED_CMD_SIZE READ(10) commands, fill as many
+ * transfer request slots as available, ring the doorbell once per batch and
+ * reap the completions. A command that did not complete successfully is
+ * reissued through the single slot path, which handles retries. If the batch
+ * times out, the pending commands are cleared and only the data of the
+ * completed ones is accounted, so a short read is returned.
+ */
+static size_t ufs_read_blocks_queued(int lun, int lba, uintptr_t buf,
+				     size_t size)
+{
+	utp_utrd_t utrd;
+	utrd_header_t *hd;
+	resp_upiu_t *resp;
+	size_t chunk, batch_size, read = 0;
+	uint32_t slots, done, failed;
+	int slot, nb_slots, result;
+
+	while (size > 0U) {
+		slots = 0U;
+		batch_size = 0U;
+		for (slot = 0; (slot < nqslots) && (batch_size < size); slot++) {
+			chunk = MIN(size - batch_size,
+				    (size_t)UFS_QUEUED_CMD_SIZE);
+			get_queued_utrd(&utrd, slot, true);
+			result = ufs_prepare_cmd(&utrd, CDBCMD_READ_10, lun,
+						 lba + (batch_size >> UFS_BLOCK_SHIFT),
+						 buf + batch_size, chunk);
+			assert(result == 0);
+			slots |= 1U << slot;
+			batch_size += chunk;
+		}
+		nb_slots = slot;
+
+		ufs_send_requests(slots);
+		result = ufs_wait_for_slots(slots, CMD_TIMEOUT_MS);
+		if (result != 0) {
+			ERROR("UFS: queued read failed (%d)\n", result);
+			done = ufs_clear_slots(slots);
+		} else {
+			done = slots;
+		}
+
+		failed = 0U;
+		batch_size = 0U;
+		for (slot = 0; slot < nb_slots; slot++) {
+			chunk = MIN(size - batch_size,
+				    (size_t)UFS_QUEUED_CMD_SIZE);
+			if ((done & (1U << slot)) == 0U) {
+				batch_size += chunk;
+				continue;
+			}
+
+			get_queued_utrd(&utrd, slot, false);
+			hd = (utrd_header_t *)utrd.header;
+			resp = (resp_upiu_t *)utrd.resp_upiu;
+			inv_dcache_range(utrd.header, sizeof(utrd_header_t));
+			inv_dcache_range(utrd.resp_upiu, utrd.size_resp_upiu);
+
+			if ((hd->ocs != OCS_SUCCESS) || (resp->status != 0U)) {
+				failed |= 1U << slot;
+			} else {
+				read += chunk - resp->res_trans_cnt;
+			}
+			batch_size += chunk;
+		}
+
+		if (result != 0) {
+			return read;
+		}
+
+		/*
+		 * The single slot path reuses the start of the descriptor area,
+		 * so only reissue once all the queued responses have been read.
+		 */
+		batch_size = 0U;
+		for (slot = 0; slot < nb_slots; slot++) {
+			chunk = MIN(size - batch_size,
+				    (size_t)UFS_QUEUED_CMD_SIZE);
+			if ((failed & (1U << slot)) != 0U) {
+				VERBOSE("UFS: reissue queued read in slot %d\n",
+					slot);
+				read += ufs_read_blocks(lun,
+					lba + (batch_size >> UFS_BLOCK_SHIFT),
+					buf + batch_size, chunk);
+			}
+			batch_size += chunk;
+		}
+
+		lba += batch_size >> UFS_BLOCK_SHIFT;
+		buf += batch_size;
+		size -= batch_size;
+	}
+
+	return read;
+}
+
 size_t ufs_read_blocks(int lun, int lba, uintptr_t buf, size_t size)
 {
 	utp_utrd_t utrd;
@@ -874,6 +1058,16 @@ size_t ufs_read_blocks(int lun, int lba, uintptr_t buf, size_t size)
 	       (ufs_params.desc_base != 0) &&
 	       (ufs_params.desc_size >= UFS_DESC_SIZE));
 
+	if ((nqslots > 1) && (size > UFS_QUEUED_CMD_SIZE)) {
+		size = ufs_read_blocks_queued(lun, lba, buf, size);
+		/*
+		 * Invalidate prefetched cache contents before cpu
+		 * accesses the buf.
+		 */
+		inv_dcache_range(buf, size);
+		return size;
+	}
+
 	ufs_send_cmd(&utrd, CDBCMD_READ_10, lun, lba, buf, size);
 #ifdef UFS_RESP_DEBUG
 	dump_upiu(&utrd);
@@ -996,6 +1190,8 @@ int ufs_init(const ufs_ops_t *ops, ufs_params_t *params)
 	if (nutrs > (ufs_params.desc_size / UFS_DESC_SIZE)) {
 		nutrs = ufs_params.desc_size / UFS_DESC_SIZE;
 	}
+	/* The first descriptor holds the UTRL of queued reads */
+	nqslots = MIN(nutrs, (int)(ufs_params.desc_size / UFS_DESC_SIZE) - 1);
 
 
 	if (ufs_params.flags & UFS_FLAGS_SKIPINIT) {
@@ -207,6 +207,7 @@
 #define ID_AA64PFR0_RAS_SHIFT			U(28)
 #define ID_AA64PFR0_RAS_MASK			ULL(0xf)
 #define ID_AA64PFR0_RAS_NOT_SUPPORTED		ULL(0x0)
+#define ID_AA64PFR0_RAS_V2			ULL(0x3)
 #define ID_AA64PFR0_RAS_LENGTH			U(4)
 
 /* Exception level handling */
@@ -1304,6 +1305,7 @@
 #define ERRIDR_MASK		U(0xffff)
 
 #define ERRSELR_EL1		S3_0_C5_C3_1
+#define ERXGSR_EL1		S3_0_C5_C3_2
 
 /* System register access to Standard Error Record registers */
 #define ERXFR_EL1		S3_0_C5_C4_0
@@ -47,6 +47,28 @@ int fdtw_for_each_cpu(const void *fdt,
 
 int fdtw_find_or_add_subnode(void *fdt, int parentoffset, const char *name);
 
+#if FDT_WRAPPERS_INDEX_SIZE
+int fdtw_index_build(const void *dtb);
+void fdtw_index_drop(const void *dtb);
+#else
+static inline int fdtw_index_build(const void *dtb)
+{
+	return -1;
+}
+
+static inline void fdtw_index_drop(const void *dtb)
+{
+}
+#endif
+
+const void *fdtw_getprop(const void *dtb, int node, const char *name,
+			 int *lenp);
+int fdtw_subnode_offset(const void *dtb, int parent, const char *name);
+int fdtw_path_offset(const void *dtb, const char *path);
+int fdtw_node_offset_by_compatible(const void *dtb, int startoffset,
+				   const char *compatible);
+int fdtw_node_offset_by_phandle(const void *dtb, uint32_t phandle);
+
 static inline uint32_t fdt_blob_size(const void *dtb)
 {
 	const uint32_t *dtb_header = (const uint32_t *)dtb;
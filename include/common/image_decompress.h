@@ -16,9 +16,31 @@ typedef int (decompressor_t)(uintptr_t *in_buf, size_t in_len,
 			     uintptr_t *out_buf, size_t out_len,
 			     uintptr_t work_buf, size_t work_len);
 
+/*
+ * Streaming decompressor: init() is given the output and workspace buffers,
+ * update() is then called with each chunk of compressed data in turn, and
+ * final() reports the end of output.
+ */
+typedef struct stream_decompressor {
+	int (*init)(uintptr_t out_buf, size_t out_len,
+		    uintptr_t work_buf, size_t work_len);
+	int (*update)(uintptr_t in_buf, size_t in_len);
+	int (*final)(uintptr_t *out_buf);
+} stream_decompressor_t;
+
+/* Size of the chunks of compressed data read in streaming mode */
+#ifndef IMAGE_DECOMPRESS_CHUNK_SIZE
+#define IMAGE_DECOMPRESS_CHUNK_SIZE	(16U * 1024U)
+#endif
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *decompressor);
 void image_decompress_prepare(struct image_info *info);
 int image_decompress(struct image_info *info);
 
+void image_decompress_stream_init(uintptr_t buf_base, uint32_t buf_size,
+				  const stream_decompressor_t *decompressor);
+int image_decompress_stream_load(unsigned int image_id,
+				 struct image_info *info);
+
 #endif /* IMAGE_DECOMPRESS_H */
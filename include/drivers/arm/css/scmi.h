@@ -7,6 +7,7 @@
 #ifndef SCMI_H
 #define SCMI_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -141,6 +142,8 @@ typedef struct scmi_channel {
 	scmi_lock_t *lock;
 	/* Indicate whether the channel is initialized */
 	int is_initialized;
+	/* Number of posted commands found to have failed */
+	unsigned int posted_errors;
 } scmi_channel_t;
 
 /* External Common API */
@@ -148,12 +151,15 @@ void *scmi_init(scmi_channel_t *ch);
 int scmi_proto_msg_attr(void *p, uint32_t proto_id, uint32_t command_id,
 						uint32_t *attr);
 int scmi_proto_version(void *p, uint32_t proto_id, uint32_t *version);
+unsigned int scmi_get_posted_errors(void *p);
 
 /*
  * Power domain protocol commands. Refer to the SCMI specification for more
  * details on these commands.
  */
 int scmi_pwr_state_set(void *p, uint32_t domain_id, uint32_t scmi_pwr_state);
+void scmi_pwr_state_set_nowait(void *p, uint32_t domain_id,
+			       uint32_t scmi_pwr_state, bool allow_queued);
 int scmi_pwr_state_get(void *p, uint32_t domain_id, uint32_t *scmi_pwr_state);
 
 /*
@@ -60,6 +60,7 @@
 #define CMD_EXTCSD_PARTITION_CONFIG	179
 #define CMD_EXTCSD_BUS_WIDTH		183
 #define CMD_EXTCSD_HS_TIMING		185
+#define CMD_EXTCSD_DEVICE_TYPE		196
 #define CMD_EXTCSD_PART_SWITCH_TIME	199
 #define CMD_EXTCSD_SEC_CNT		212
 #define CMD_EXTCSD_BOOT_SIZE_MULT	226
@@ -91,6 +92,11 @@
 #define EXTCSD_VALUE(x)			(((x) & 0xff) << 8)
 #define EXTCSD_CMD_SET_NORMAL		U(1)
 
+#define EXTCSD_HS_TIMING_HS200		U(2)
+#define EXTCSD_DEVICE_TYPE_HS200_1V8	BIT(4)
+#define EXTCSD_DEVICE_TYPE_HS200_1V2	BIT(5)
+#define MMC_HS200_MAX_FREQ		U(200000000)
+
 #define CSD_TRAN_SPEED_UNIT_MASK	GENMASK(2, 0)
 #define CSD_TRAN_SPEED_MULT_MASK	GENMASK(6, 3)
 #define CSD_TRAN_SPEED_MULT_SHIFT	3
@@ -113,6 +119,10 @@
 
 #define MMC_FLAG_CMD23			(U(1) << 0)
 #define MMC_FLAG_SD_CMD6		(U(1) << 1)
+/* Switch eMMC devices to HS200, requires the execute_tuning() op */
+#define MMC_FLAG_HS200			(U(1) << 2)
+/* ops->read() only returns once the device is done with the transfer */
+#define MMC_FLAG_BUSY_END		(U(1) << 3)
 
 #define CMD8_CHECK_PATTERN		U(0xAA)
 #define VHS_2_7_3_6_V			BIT(8)
@@ -138,6 +148,8 @@ struct mmc_ops {
 	int (*prepare)(int lba, uintptr_t buf, size_t size);
 	int (*read)(int lba, uintptr_t buf, size_t size);
 	int (*write)(int lba, const uintptr_t buf, size_t size);
+	/* Optional: HS200 sampling point tuning (CMD21) */
+	int (*execute_tuning)(void);
 };
 
 struct mmc_csd_emmc {
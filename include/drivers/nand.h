@@ -31,6 +31,9 @@ struct nand_device {
 	int (*mtd_block_is_bad)(unsigned int block);
 	int (*mtd_read_page)(struct nand_device *nand, unsigned int page,
 			     uintptr_t buffer);
+	/* Optional: read consecutive full pages from a single block */
+	int (*mtd_read_pages)(struct nand_device *nand, unsigned int page,
+			      unsigned int nb_pages, uintptr_t buffer);
 };
 
 void plat_get_scratch_buffer(void **buffer_addr, size_t *buf_size);
@@ -11,6 +11,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <lib/spinlock.h>
+
 /* Minimum size expected for SMT based shared memory message buffers */
 #define SMT_BUF_SLOT_SIZE	128U
 
@@ -23,12 +25,18 @@ struct scmi_msg_channel;
  * @shm_addr: Address of the shared memory for the SCMI channel
  * @shm_size: Byte size of the shared memory for the SCMI channel
  * @busy: True when channel is busy, false when channel is free
+ * @lock: SMP protection on the channel busy state
+ * @shm_trusted: True when the shared memory cannot be accessed by the
+ *	non-secure world while the message is processed. Input payload is then
+ *	processed in place, without copy into secure memory.
  * @agent_name: Agent name, SCMI protocol exposes 16 bytes max, or NULL
  */
 struct scmi_msg_channel {
 	uintptr_t shm_addr;
 	size_t shm_size;
 	bool busy;
+	spinlock_t lock;
+	bool shm_trusted;
 	const char *agent_name;
 };
 
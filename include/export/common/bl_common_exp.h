@@ -25,6 +25,8 @@
 
 #define IMAGE_ATTRIB_SKIP_LOADING	U(0x02)
 #define IMAGE_ATTRIB_PLAT_SETUP		U(0x04)
+/* Image is gzip-compressed and decompressed while it is read (BL2 only) */
+#define IMAGE_ATTRIB_DECOMPRESS_STREAM	U(0x08)
 
 #define INVALID_IMAGE_ID		U(0xFFFFFFFF)
 
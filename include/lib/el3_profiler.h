@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef EL3_PROFILER_H
+#define EL3_PROFILER_H
+
+#include <lib/utils_def.h>
+
+/*
+ * Classes of EL3 activity the profiler keeps statistics for. Class 0 is never
+ * used so that a zero key denotes an unused slot.
+ */
+#define EL3_PROF_CLASS_SMC		U(1)	/* id: SMC function ID */
+#define EL3_PROF_CLASS_INTR		U(2)	/* id: interrupt type */
+#define EL3_PROF_CLASS_EHF		U(3)	/* id: interrupt ID */
+#define EL3_PROF_CLASS_CTX		U(4)	/* id: EL3_PROF_CTX_ID() */
+#define EL3_PROF_CLASS_SP		U(5)	/* id: partition ID */
+#define EL3_PROF_CLASS_SCMI		U(6)	/* id: SCMI protocol ID */
+
+#define EL3_PROF_KEY(_class, _id)	\
+	(((uint64_t)(_class) << 32) | (uint32_t)(_id))
+#define EL3_PROF_KEY_CLASS(_key)	((uint32_t)((_key) >> 32))
+#define EL3_PROF_KEY_ID(_key)		((uint32_t)(_key))
+
+/* Context management operations, combined with the security state */
+#define EL3_PROF_CTX_EL1_SAVE		U(0)
+#define EL3_PROF_CTX_EL1_RESTORE	U(1)
+#define EL3_PROF_CTX_EL2_SAVE		U(2)
+#define EL3_PROF_CTX_EL2_RESTORE	U(3)
+#define EL3_PROF_CTX_ID(_op, _ss)	(((_op) << 8) | (_ss))
+
+/*
+ * Durations are counted in system counter ticks. Bucket 0 counts samples of
+ * zero ticks and bucket N (N > 0) samples of [2^(N-1), 2^N) ticks; the last
+ * bucket also counts everything longer.
+ */
+#define EL3_PROF_HIST_BUCKETS		U(24)
+
+/*
+ * The field of a statistics slot returned through the PMF SMC interface is
+ * selected by bits [11:8] of the flags argument. The slot is the timestamp ID.
+ */
+#define EL3_PROF_FIELD_SHIFT		U(8)
+#define EL3_PROF_FIELD_MASK		U(0xF)
+#define EL3_PROF_FIELD_KEY		U(0)
+#define EL3_PROF_FIELD_COUNT		U(1)
+#define EL3_PROF_FIELD_TOTAL		U(2)
+#define EL3_PROF_FIELD_MAX		U(3)
+#define EL3_PROF_FIELD_P50		U(4)
+#define EL3_PROF_FIELD_P99		U(5)
+#define EL3_PROF_FIELD_DROPPED		U(6)
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <bl31/interrupt_mgmt.h>
+#include <common/runtime_svc.h>
+#include <platform_def.h>
+
+/* Number of statistics slots per CPU. Must be a power of 2. */
+#ifndef PLAT_EL3_PROF_MAX_KEYS
+#define PLAT_EL3_PROF_MAX_KEYS		U(32)
+#endif
+
+struct el3_prof_entry {
+	uint64_t key;
+	uint64_t count;
+	uint64_t total;
+	uint64_t max;
+	uint32_t hist[EL3_PROF_HIST_BUCKETS];
+};
+
+struct el3_prof_cpu {
+	struct el3_prof_entry entries[PLAT_EL3_PROF_MAX_KEYS];
+	/* Samples lost because all the slots were in use */
+	uint64_t dropped;
+} __aligned(CACHE_WRITEBACK_GRANULE);
+
+#if ENABLE_EL3_PROFILER && IMAGE_BL31
+extern struct el3_prof_cpu el3_prof_data[PLATFORM_CORE_COUNT];
+
+static inline uint64_t el3_prof_now(void)
+{
+	return read_cntpct_el0();
+}
+
+void el3_prof_record(uint64_t key, uint64_t start);
+
+/* Called from the exception vectors to time the handlers they dispatch to */
+uintptr_t el3_prof_smc_handler(uint32_t smc_fid, u_register_t x1,
+			       u_register_t x2, u_register_t x3,
+			       u_register_t x4, void *cookie, void *handle,
+			       u_register_t flags, rt_svc_handle_t handler);
+uint64_t el3_prof_intr_handler(uint32_t id, uint32_t flags, void *handle,
+			       void *cookie, interrupt_type_handler_t handler,
+			       uint32_t type);
+#else
+static inline uint64_t el3_prof_now(void)
+{
+	return 0ULL;
+}
+
+static inline void el3_prof_record(uint64_t key, uint64_t start)
+{
+}
+#endif /* ENABLE_EL3_PROFILER && IMAGE_BL31 */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* EL3_PROFILER_H */
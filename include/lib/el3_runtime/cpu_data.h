@@ -14,10 +14,17 @@
 /* Size of psci_cpu_data structure */
 #define PSCI_CPU_DATA_SIZE		12
 
-#ifdef __aarch64__
-
+#if PSCI_CACHE_LINE_ALIGN
+/* The PSCI data is kept at the end of cpu_data, see CPU_DATA_PSCI_OFFSET */
+#define CPU_DATA_PSCI_INLINE_SIZE	0
+#elif defined(__aarch64__)
 /* 8-bytes aligned size of psci_cpu_data structure */
-#define PSCI_CPU_DATA_SIZE_ALIGNED	((PSCI_CPU_DATA_SIZE + 7) & ~7)
+#define CPU_DATA_PSCI_INLINE_SIZE	((PSCI_CPU_DATA_SIZE + 7) & ~7)
+#else
+#define CPU_DATA_PSCI_INLINE_SIZE	PSCI_CPU_DATA_SIZE
+#endif
+
+#ifdef __aarch64__
 
 #if ENABLE_RME
 /* Size of cpu_context array */
@@ -31,11 +38,11 @@
 
 #if ENABLE_PAUTH
 /* 8-bytes aligned offset of apiakey[2], size 16 bytes */
-#define	CPU_DATA_APIAKEY_OFFSET		(0x8 + PSCI_CPU_DATA_SIZE_ALIGNED \
+#define	CPU_DATA_APIAKEY_OFFSET		(0x8 + CPU_DATA_PSCI_INLINE_SIZE \
 					     + CPU_DATA_CPU_OPS_PTR)
 #define CPU_DATA_CRASH_BUF_OFFSET	(0x10 + CPU_DATA_APIAKEY_OFFSET)
 #else /* ENABLE_PAUTH */
-#define CPU_DATA_CRASH_BUF_OFFSET	(0x8 + PSCI_CPU_DATA_SIZE_ALIGNED \
+#define CPU_DATA_CRASH_BUF_OFFSET	(0x8 + CPU_DATA_PSCI_INLINE_SIZE \
 					     + CPU_DATA_CPU_OPS_PTR)
 #endif /* ENABLE_PAUTH */
 
@@ -48,7 +55,7 @@
 #error "Crash reporting is not supported in AArch32"
 #endif
 #define CPU_DATA_CPU_OPS_PTR		0x0
-#define CPU_DATA_CRASH_BUF_OFFSET	(0x4 + PSCI_CPU_DATA_SIZE)
+#define CPU_DATA_CRASH_BUF_OFFSET	(0x4 + CPU_DATA_PSCI_INLINE_SIZE)
 
 #endif	/* __aarch64__ */
 
@@ -59,11 +66,29 @@
 #define CPU_DATA_CRASH_BUF_END		CPU_DATA_CRASH_BUF_OFFSET
 #endif
 
+#if PSCI_CACHE_LINE_ALIGN
+/*
+ * The PSCI data is written by other cpus, so it is kept on its own cache lines
+ * after the data that is only accessed by the owning cpu.
+ */
+#define CPU_DATA_PSCI_OFFSET		(((CPU_DATA_CRASH_BUF_END + \
+					CACHE_WRITEBACK_GRANULE - 1) / \
+						CACHE_WRITEBACK_GRANULE) * \
+							CACHE_WRITEBACK_GRANULE)
+
+/* cpu_data size is the data size rounded up to the platform cache line size */
+#define CPU_DATA_SIZE			(CPU_DATA_PSCI_OFFSET + \
+					(((PSCI_CPU_DATA_SIZE + \
+					CACHE_WRITEBACK_GRANULE - 1) / \
+						CACHE_WRITEBACK_GRANULE) * \
+							CACHE_WRITEBACK_GRANULE))
+#else
 /* cpu_data size is the data size rounded up to the platform cache line size */
 #define CPU_DATA_SIZE			(((CPU_DATA_CRASH_BUF_END + \
 					CACHE_WRITEBACK_GRANULE - 1) / \
 						CACHE_WRITEBACK_GRANULE) * \
 							CACHE_WRITEBACK_GRANULE)
+#endif /* PSCI_CACHE_LINE_ALIGN */
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
 /* Temporary space to store PMF timestamps from assembly code */
@@ -110,7 +135,10 @@ typedef enum context_pas {
  *   Pointers to non-secure, realm, and secure security state contexts
  *   Address of the crash stack
  * It is aligned to the cache line boundary to allow efficient concurrent
- * manipulation of these pointers on different cpus
+ * manipulation of these pointers on different cpus. With PSCI_CACHE_LINE_ALIGN,
+ * the PSCI data, which other cpus write during power management operations, is
+ * kept on separate cache lines so that it doesn't evict the rest of the data
+ * from the owning cpu.
  *
  * The data structure and the _cpu_data accessors should not be used directly
  * by components that have per-cpu members. The member access macros should be
@@ -121,7 +149,9 @@ typedef struct cpu_data {
 	void *cpu_context[CPU_DATA_CONTEXT_NUM];
 #endif /* __aarch64__ */
 	uintptr_t cpu_ops_ptr;
+#if !PSCI_CACHE_LINE_ALIGN
 	struct psci_cpu_data psci_svc_cpu_data;
+#endif
 #if ENABLE_PAUTH
 	uint64_t apiakey[2];
 #endif
@@ -137,6 +167,10 @@ typedef struct cpu_data {
 #if defined(IMAGE_BL31) && EL3_EXCEPTION_HANDLING
 	pe_exc_data_t ehf_data;
 #endif
+#if PSCI_CACHE_LINE_ALIGN
+	struct psci_cpu_data psci_svc_cpu_data
+		__aligned(CACHE_WRITEBACK_GRANULE);
+#endif
 } __aligned(CACHE_WRITEBACK_GRANULE) cpu_data_t;
 
 extern cpu_data_t percpu_data[PLATFORM_CORE_COUNT];
@@ -162,6 +196,12 @@ CASSERT(CPU_DATA_CRASH_BUF_OFFSET == __builtin_offsetof
 CASSERT(CPU_DATA_SIZE == sizeof(cpu_data_t),
 		assert_cpu_data_size_mismatch);
 
+#if PSCI_CACHE_LINE_ALIGN
+CASSERT(CPU_DATA_PSCI_OFFSET == __builtin_offsetof
+		(cpu_data_t, psci_svc_cpu_data),
+		assert_cpu_data_psci_offset_mismatch);
+#endif
+
 CASSERT(CPU_DATA_CPU_OPS_PTR == __builtin_offsetof
 		(cpu_data_t, cpu_ops_ptr),
 		assert_cpu_data_cpu_ops_ptr_offset_mismatch);
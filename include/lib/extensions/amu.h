@@ -7,6 +7,7 @@
 #ifndef AMU_H
 #define AMU_H
 
+#include <cdefs.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -69,4 +70,40 @@ const struct amu_topology *plat_amu_topology(void);
 #endif /* ENABLE_AMU_FCONF */
 #endif /* ENABLE_AMU_AUXILIARY_COUNTERS */
 
+#if AMU_SNAPSHOT
+/* Number of counters of each group that AMU snapshots have room for */
+#define AMU_SNAPSHOT_GROUP0_COUNTERS	U(4)
+#define AMU_SNAPSHOT_GROUP1_COUNTERS	U(16)
+
+/* Power transition of the core that the snapshot was taken at */
+#define AMU_SNAPSHOT_EVENT_NONE		U(0)
+#define AMU_SNAPSHOT_EVENT_CPU_ON	U(1)
+#define AMU_SNAPSHOT_EVENT_PWRDOWN	U(2)
+#define AMU_SNAPSHOT_EVENT_PWRUP	U(3)
+
+/*
+ * AMU counters of a core, published by EL3 at every power transition into
+ * the PLAT_AMU_SNAPSHOT_BASE region, which holds one snapshot per core in
+ * core position order. Each snapshot sits in its own cache line(s) so that
+ * cores never write the same line.
+ *
+ * The region is read-only to the normal world, which follows the seqlock
+ * protocol: read `seq`, retrying while it is odd; read the snapshot; then
+ * read `seq` again, retrying if it changed. Barriers are required between
+ * the three steps.
+ */
+struct amu_snapshot {
+	uint64_t seq;
+	uint64_t timestamp;	/* CNTPCT_EL0 when the snapshot was taken */
+	uint32_t event;		/* One of AMU_SNAPSHOT_EVENT_* */
+	uint16_t group0_num;	/* Number of valid group 0 counters */
+	uint16_t group1_num;	/* Number of valid group 1 counters */
+	uint64_t group0_cnts[AMU_SNAPSHOT_GROUP0_COUNTERS];
+	uint64_t group1_cnts[AMU_SNAPSHOT_GROUP1_COUNTERS];
+} __aligned(CACHE_WRITEBACK_GRANULE);
+
+/* Size of the region that the platform must map at PLAT_AMU_SNAPSHOT_BASE */
+#define AMU_SNAPSHOT_SIZE	(PLATFORM_CORE_COUNT * sizeof(struct amu_snapshot))
+#endif /* AMU_SNAPSHOT */
+
 #endif /* AMU_H */
@@ -14,6 +14,15 @@
 #define ERR_ACCESS_SYSREG	0
 #define ERR_ACCESS_MEMMAP	1
 
+/*
+ * SiP SMC to read the counters of an error record group. x1 holds the group
+ * index; on success, x1-x3 return the number of handled, corrected and
+ * throttled errors, and x4 the number of record groups. Returns SMC_UNK for
+ * an unknown group.
+ */
+#define RAS_SMC_GET_ERR_STATS	U(0xC2000040)
+#define is_ras_fid(_fid)	((_fid) == RAS_SMC_GET_ERR_STATS)
+
 /*
  * Register all error records on the platform.
  *
@@ -115,6 +124,24 @@ struct err_handler_data {
 typedef int (*err_record_handler_t)(const struct err_record_info *info,
 		int probe_data, const struct err_handler_data *const data);
 
+#if RAS_ERR_STATS
+/* Error counters kept for each error record group */
+struct ras_err_stats {
+	/* Errors passed on to the group handler */
+	uint64_t handled;
+
+	/* Corrected errors reported by Standard Error Records of the group */
+	uint64_t corrected;
+
+	/* Corrected errors cleared without calling the group handler */
+	uint64_t throttled;
+
+	/* Start, in counter ticks, and usage of the rate limiting window */
+	uint64_t window_start;
+	unsigned int window_count;
+};
+#endif
+
 /* Error record information */
 struct err_record_info {
 	/* Function to probe error record group for errors */
@@ -155,6 +182,11 @@ struct err_record_info {
 
 	/* Error record access mechanism */
 	unsigned int access:1;
+
+#if RAS_ERR_STATS
+	/* Updated by the RAS framework; not to be initialised by platforms */
+	struct ras_err_stats stats;
+#endif
 };
 
 struct err_record_mapping {
@@ -175,29 +207,23 @@ extern const struct ras_interrupt_mapping ras_interrupt_mappings;
  * Helper functions to probe memory-mapped and system registers implemented in
  * Standard Error Record format
  */
-static inline int ras_err_ser_probe_memmap(const struct err_record_info *info,
-		int *probe_data)
-{
-	assert(info->version == ERR_HANDLER_VERSION);
-
-	return ser_probe_memmap(info->memmap.base_addr, info->memmap.size_num_k,
-		probe_data);
-}
-
-static inline int ras_err_ser_probe_sysreg(const struct err_record_info *info,
-		int *probe_data)
-{
-	assert(info->version == ERR_HANDLER_VERSION);
-
-	return ser_probe_sysreg(info->sysreg.idx_start, info->sysreg.num_idx,
-			probe_data);
-}
+int ras_err_ser_probe_memmap(const struct err_record_info *info,
+		int *probe_data);
+int ras_err_ser_probe_sysreg(const struct err_record_info *info,
+		int *probe_data);
 
 const char *ras_serr_to_str(unsigned int serr);
 int ras_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 		void *handle, uint64_t flags);
 void ras_init(void);
 
+#if RAS_ERR_STATS
+int ras_get_err_stats(unsigned int group, struct ras_err_stats *stats);
+uintptr_t ras_smc_handler(unsigned int smc_fid, u_register_t x1,
+		u_register_t x2, u_register_t x3, u_register_t x4,
+		void *cookie, void *handle, u_register_t flags);
+#endif
+
 #endif /* __ASSEMBLER__ */
 
 #endif /* RAS_H */
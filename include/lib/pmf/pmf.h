@@ -53,6 +53,8 @@
 /* Following are the supported PMF service IDs */
 #define PMF_PSCI_STAT_SVC_ID	0
 #define PMF_RT_INSTR_SVC_ID	1
+#define PMF_EL3_PROF_SVC_ID	2
+#define PMF_SPMD_PI_SVC_ID	3
 
 /*******************************************************************************
  * Function & variable prototypes
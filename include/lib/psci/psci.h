@@ -295,6 +295,8 @@ typedef struct psci_power_state {
  * Structure used to store per-cpu information relevant to the PSCI service.
  * It is populated in the per-cpu data array. In return we get a guarantee that
  * this information will not reside on a cache line shared with another cpu.
+ * As it is written by other cpus, e.g. by CPU_ON, PSCI_CACHE_LINE_ALIGN also
+ * keeps it on a different cache line than the rest of the per-cpu data.
  ******************************************************************************/
 typedef struct psci_cpu_data {
 	/* State as seen by PSCI Affinity Info API */
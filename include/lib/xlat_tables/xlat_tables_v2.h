@@ -76,6 +76,9 @@
 #define MT_SHAREABILITY_MASK	(U(3) << MT_SHAREABILITY_SHIFT)
 #define MT_SHAREABILITY(_attr)	((_attr) & MT_SHAREABILITY_MASK)
 
+/* Scratch window (see MAP_SCRATCH_WINDOW()) */
+#define MT_SCRATCH_SHIFT	U(10)
+
 /* All other bits are reserved */
 
 /*
@@ -130,6 +133,14 @@
 #define MT_SHAREABILITY_OSH	(U(2) << MT_SHAREABILITY_SHIFT)
 #define MT_SHAREABILITY_NSH	(U(3) << MT_SHAREABILITY_SHIFT)
 
+/*
+ * Reserve the VA range of the region as a scratch window: translation tables
+ * are allocated down to the granularity of the region, but their entries are
+ * left invalid until the window is mapped with xlat_map_scratch_window_ctx().
+ * The PA and the other attributes of the region are ignored.
+ */
+#define MT_SCRATCH		(U(1) << MT_SCRATCH_SHIFT)
+
 /* Compound attributes for most common usages */
 #define MT_CODE			(MT_MEMORY | MT_RO | MT_EXECUTE)
 #define MT_RO_DATA		(MT_MEMORY | MT_RO | MT_EXECUTE_NEVER)
@@ -412,5 +423,57 @@ int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				uint32_t *attr);
 int xlat_get_mem_attributes(uintptr_t base_va, uint32_t *attr);
 
+/*
+ * Scratch windows are ranges of VA reserved for short-lived mappings that can
+ * be retargeted at runtime without adding or removing a dynamic region, so
+ * they don't need to search or shift the mmap array. The windows must be
+ * declared as a static region with MAP_SCRATCH_WINDOW(), which allocates the
+ * last level tables of the range but leaves it unmapped. A context has at most
+ * one such region. A typical use is to reserve one window per CPU in it for
+ * transient buffers.
+ *
+ * xlat_map_scratch_window_ctx() maps 'size' bytes starting at 'base_pa' into
+ * the window at 'window_va' with the attributes 'attr', replacing any previous
+ * mapping of the window. xlat_unmap_scratch_window_ctx() makes the window
+ * inaccessible again. [window_va, window_va + size) must be fully inside the
+ * region declared with MAP_SCRATCH_WINDOW().
+ *
+ * Return 0 on success, a negative error code on error.
+ *
+ * NOTE: The caller is responsible for making sure that a window isn't used by
+ * two users at the same time.
+ */
+#define MAP_SCRATCH_WINDOW(_va, _sz)					\
+	MAP_REGION2((_va), (_va), (_sz),				\
+		    MT_SCRATCH | MT_DEVICE | MT_RO | MT_SECURE |	\
+		    MT_EXECUTE_NEVER, PAGE_SIZE)
+
+int xlat_map_scratch_window_ctx(const xlat_ctx_t *ctx, uintptr_t window_va,
+				unsigned long long base_pa, size_t size,
+				uint32_t attr);
+int xlat_map_scratch_window(uintptr_t window_va, unsigned long long base_pa,
+			    size_t size, uint32_t attr);
+int xlat_unmap_scratch_window_ctx(const xlat_ctx_t *ctx, uintptr_t window_va,
+				  size_t size);
+int xlat_unmap_scratch_window(uintptr_t window_va, size_t size);
+
+#if PLAT_XLAT_CPU_WINDOWS
+/*
+ * Map a physical range into the scratch window of the current CPU, which is
+ * the slice of PLAT_XLAT_CPU_WINDOW_SIZE bytes at PLAT_XLAT_CPU_WINDOW_BASE
+ * owned by that CPU. The windows are in translation tables shared by all CPUs,
+ * so TLB maintenance is broadcast, but the returned address must not be
+ * shared with other CPUs as the mappings of a CPU are not locked.
+ *
+ * Mappings of a CPU are stacked and must be released with
+ * xlat_cpu_window_unmap() in the reverse order of creation, passing the same
+ * address and size. The base PA and size don't need to be page aligned.
+ *
+ * Return the VA of 'pa', or NULL if the window of the CPU is too small.
+ */
+void *xlat_cpu_window_map(unsigned long long pa, size_t size, uint32_t attr);
+void xlat_cpu_window_unmap(const void *va, size_t size);
+#endif /* PLAT_XLAT_CPU_WINDOWS */
+
 #endif /*__ASSEMBLER__*/
 #endif /* XLAT_TABLES_V2_H */
@@ -102,6 +102,14 @@ struct xlat_ctx {
 	/* Level of the base translation table. */
 	unsigned int base_level;
 
+	/*
+	 * VA range of the region declared with MAP_SCRATCH_WINDOW(), if any.
+	 * It is recorded when the translation tables are initialized and never
+	 * changes afterwards, so it can be checked without a lock.
+	 */
+	uintptr_t scratch_base_va;
+	size_t scratch_size;
+
 	/* Set to true when the translation tables are initialized. */
 	bool initialized;
 
@@ -35,7 +35,8 @@ enum {
 	DEV_ROOT_QFIP,
 	DEV_ROOT_QBLOBS,
 	DEV_ROOT_QBLOBCTL,
-	DEV_ROOT_QPSCI
+	DEV_ROOT_QPSCI,
+	DEV_ROOT_QEL3PROF
 };
 
 /*******************************************************************************
@@ -7,6 +7,7 @@
 #include <assert.h>
 #include <common/debug.h>
 #include <lib/debugfs.h>
+#include <lib/el3_profiler.h>
 
 #include "blobs.h"
 #include "dev.h"
@@ -21,6 +22,11 @@ static const dirtab_t dirtab[] = {
 };
 
 static const dirtab_t devfstab[] = {
+#if ENABLE_EL3_PROFILER
+	/* Raw per-CPU struct el3_prof_cpu statistics of the EL3 profiler */
+	{"el3prof", DEV_ROOT_QEL3PROF, sizeof(el3_prof_data), O_READ,
+	 el3_prof_data}
+#endif
 };
 
 /*******************************************************************************
@@ -72,6 +78,13 @@ static int rootread(chan_t *channel, void *buf, int size)
 		return dirread(channel, dir, NULL, 0, rootgen);
 	}
 
+#if ENABLE_EL3_PROFILER
+	if (channel->qid == DEV_ROOT_QEL3PROF) {
+		return buf_to_channel(channel, buf, el3_prof_data, size,
+				      sizeof(el3_prof_data));
+	}
+#endif
+
 	/* Only makes sense when using debug language */
 	assert(channel->qid != DEV_ROOT_QBLOBCTL);
 
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <bl31/interrupt_mgmt.h>
+#include <common/runtime_svc.h>
+#include <lib/cassert.h>
+#include <lib/el3_profiler.h>
+#include <lib/pmf/pmf.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+CASSERT(IS_POWER_OF_TWO(PLAT_EL3_PROF_MAX_KEYS) &&
+	(PLAT_EL3_PROF_MAX_KEYS <= 128U), assert_el3_prof_max_keys);
+
+/*
+ * Statistics of each CPU. Only the owning CPU updates its statistics, with
+ * interrupts masked, so no locking is needed. Readers on other CPUs take no
+ * lock either and may see a slot in the middle of an update.
+ */
+struct el3_prof_cpu el3_prof_data[PLATFORM_CORE_COUNT];
+
+static unsigned int el3_prof_hash(uint64_t key)
+{
+	/* Fibonacci hashing, so that consecutive IDs spread over the slots */
+	return (unsigned int)((key * 0x9E3779B97F4A7C15ULL) >> 32) &
+		(PLAT_EL3_PROF_MAX_KEYS - 1U);
+}
+
+/*
+ * Find the slot of a key, or claim an unused one for it. Keys are never
+ * removed, so the first unused slot on the probe sequence ends the search.
+ */
+static struct el3_prof_entry *el3_prof_lookup(struct el3_prof_cpu *prof,
+					      uint64_t key)
+{
+	unsigned int i, slot = el3_prof_hash(key);
+	struct el3_prof_entry *entry;
+
+	for (i = 0U; i < PLAT_EL3_PROF_MAX_KEYS; i++) {
+		entry = &prof->entries[(slot + i) & (PLAT_EL3_PROF_MAX_KEYS - 1U)];
+		if (entry->key == key) {
+			return entry;
+		}
+
+		if (entry->key == 0ULL) {
+			entry->key = key;
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static unsigned int el3_prof_bucket(uint64_t ticks)
+{
+	unsigned int bucket;
+
+	if (ticks == 0ULL) {
+		return 0U;
+	}
+
+	bucket = 64U - (unsigned int)__builtin_clzll(ticks);
+	return MIN(bucket, EL3_PROF_HIST_BUCKETS - 1U);
+}
+
+/*
+ * Account the time elapsed since 'start', a value of el3_prof_now(), to 'key'
+ * in the statistics of the calling CPU.
+ */
+void el3_prof_record(uint64_t key, uint64_t start)
+{
+	uint64_t ticks = el3_prof_now() - start;
+	struct el3_prof_cpu *prof = &el3_prof_data[plat_my_core_pos()];
+	struct el3_prof_entry *entry;
+	unsigned int bucket;
+
+	assert(EL3_PROF_KEY_CLASS(key) != 0U);
+
+	entry = el3_prof_lookup(prof, key);
+	if (entry == NULL) {
+		prof->dropped++;
+		return;
+	}
+
+	entry->count++;
+	entry->total += ticks;
+	if (ticks > entry->max) {
+		entry->max = ticks;
+	}
+
+	/* Let the buckets saturate rather than wrap */
+	bucket = el3_prof_bucket(ticks);
+	if (entry->hist[bucket] != UINT32_MAX) {
+		entry->hist[bucket]++;
+	}
+}
+
+/*
+ * Called from the SMC exception vector in place of the runtime service
+ * handler, to time the handler.
+ */
+uintptr_t el3_prof_smc_handler(uint32_t smc_fid,
+			       u_register_t x1,
+			       u_register_t x2,
+			       u_register_t x3,
+			       u_register_t x4,
+			       void *cookie,
+			       void *handle,
+			       u_register_t flags,
+			       rt_svc_handle_t handler)
+{
+	uint64_t start = el3_prof_now();
+	uintptr_t ret;
+
+	ret = handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
+	el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_SMC, smc_fid), start);
+
+	return ret;
+}
+
+/*
+ * Called from the interrupt exception vector in place of the handler of the
+ * interrupt type, to time the handler.
+ */
+uint64_t el3_prof_intr_handler(uint32_t id,
+			       uint32_t flags,
+			       void *handle,
+			       void *cookie,
+			       interrupt_type_handler_t handler,
+			       uint32_t type)
+{
+	uint64_t start = el3_prof_now();
+	uint64_t ret;
+
+	ret = handler(id, flags, handle, cookie);
+	el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_INTR, type), start);
+
+	return ret;
+}
+
+#if ENABLE_PMF
+/*
+ * Return an upper bound, in ticks, of the given percentile of the durations
+ * recorded in a slot. The histogram resolution is a power of 2.
+ */
+static uint64_t el3_prof_percentile(const struct el3_prof_entry *entry,
+				    unsigned int percent)
+{
+	uint64_t samples = 0ULL, rank, seen = 0ULL;
+	unsigned int bucket;
+
+	for (bucket = 0U; bucket < EL3_PROF_HIST_BUCKETS; bucket++) {
+		samples += entry->hist[bucket];
+	}
+
+	if (samples == 0ULL) {
+		return 0ULL;
+	}
+
+	rank = div_round_up(samples * percent, 100U);
+	for (bucket = 0U; bucket < (EL3_PROF_HIST_BUCKETS - 1U); bucket++) {
+		seen += entry->hist[bucket];
+		if (seen >= rank) {
+			return MIN((uint64_t)1U << bucket, entry->max);
+		}
+	}
+
+	/* The last bucket has no upper bound */
+	return entry->max;
+}
+
+/*
+ * PMF interface to the statistics: the timestamp ID selects a slot and the
+ * flags the field of the slot to return.
+ */
+static unsigned long long el3_prof_get_stat(unsigned int tid,
+					    u_register_t mpidr,
+					    unsigned int flags)
+{
+	const struct el3_prof_cpu *prof;
+	const struct el3_prof_entry *entry;
+	int cpu = plat_core_pos_by_mpidr(mpidr);
+
+	if (cpu < 0) {
+		return 0ULL;
+	}
+
+	prof = &el3_prof_data[cpu];
+	entry = &prof->entries[(tid & PMF_TID_MASK) %
+			       PLAT_EL3_PROF_MAX_KEYS];
+
+	switch ((flags >> EL3_PROF_FIELD_SHIFT) & EL3_PROF_FIELD_MASK) {
+	case EL3_PROF_FIELD_KEY:
+		return entry->key;
+	case EL3_PROF_FIELD_COUNT:
+		return entry->count;
+	case EL3_PROF_FIELD_TOTAL:
+		return entry->total;
+	case EL3_PROF_FIELD_MAX:
+		return entry->max;
+	case EL3_PROF_FIELD_P50:
+		return el3_prof_percentile(entry, 50U);
+	case EL3_PROF_FIELD_P99:
+		return el3_prof_percentile(entry, 99U);
+	case EL3_PROF_FIELD_DROPPED:
+		return prof->dropped;
+	default:
+		return 0ULL;
+	}
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(el3_prof_svc, PMF_ARM_TIF_IMPL_ID,
+	PMF_EL3_PROF_SVC_ID, PLAT_EL3_PROF_MAX_KEYS, NULL, el3_prof_get_stat)
+#endif /* ENABLE_PMF */
@@ -19,6 +19,7 @@
 #include <common/debug.h>
 #include <context.h>
 #include <drivers/arm/gicv3.h>
+#include <lib/el3_profiler.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/cpu_data.h>
 #include <lib/el3_runtime/pubsub_events.h>
@@ -1223,6 +1224,7 @@ void cm_el2_sysregs_context_save(uint32_t security_state)
 {
 	cpu_context_t *ctx;
 	el2_sysregs_t *el2_sysregs_ctx;
+	uint64_t start = el3_prof_now();
 
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
@@ -1287,6 +1289,9 @@ void cm_el2_sysregs_context_save(uint32_t security_state)
 		write_ctx_reg(el2_sysregs_ctx, CTX_GCSPR_EL2, read_gcspr_el2());
 		write_ctx_reg(el2_sysregs_ctx, CTX_GCSCR_EL2, read_gcscr_el2());
 	}
+
+	el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_CTX,
+		EL3_PROF_CTX_ID(EL3_PROF_CTX_EL2_SAVE, security_state)), start);
 }
 
 /*******************************************************************************
@@ -1296,6 +1301,7 @@ void cm_el2_sysregs_context_restore(uint32_t security_state)
 {
 	cpu_context_t *ctx;
 	el2_sysregs_t *el2_sysregs_ctx;
+	uint64_t start = el3_prof_now();
 
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
@@ -1359,6 +1365,9 @@ void cm_el2_sysregs_context_restore(uint32_t security_state)
 		write_gcscr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_GCSCR_EL2));
 		write_gcspr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_GCSPR_EL2));
 	}
+
+	el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_CTX,
+		EL3_PROF_CTX_ID(EL3_PROF_CTX_EL2_RESTORE, security_state)), start);
 }
 #endif /* CTX_INCLUDE_EL2_REGS */
 
@@ -1398,6 +1407,7 @@ void cm_prepare_el3_exit_ns(void)
 void cm_el1_sysregs_context_save(uint32_t security_state)
 {
 	cpu_context_t *ctx;
+	uint64_t start = el3_prof_now();
 
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
@@ -1410,11 +1420,15 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 	else
 		PUBLISH_EVENT(cm_exited_normal_world);
 #endif
+
+	el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_CTX,
+		EL3_PROF_CTX_ID(EL3_PROF_CTX_EL1_SAVE, security_state)), start);
 }
 
 void cm_el1_sysregs_context_restore(uint32_t security_state)
 {
 	cpu_context_t *ctx;
+	uint64_t start = el3_prof_now();
 
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
@@ -1427,6 +1441,9 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 	else
 		PUBLISH_EVENT(cm_entering_normal_world);
 #endif
+
+	el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_CTX,
+		EL3_PROF_CTX_ID(EL3_PROF_CTX_EL1_RESTORE, security_state)), start);
 }
 
 /*******************************************************************************
@@ -17,6 +17,7 @@
 #include <common/debug.h>
 #include <lib/el3_runtime/pubsub_events.h>
 #include <lib/extensions/amu.h>
+#include <lib/utils.h>
 
 #include <plat/common/platform.h>
 
@@ -57,6 +58,58 @@ CASSERT((sizeof(amu_ctxs_[0].group1_enable) * CHAR_BIT) <= AMU_GROUP1_MAX_COUNTE
 	amu_ctx_group1_enable_cannot_represent_all_group1_counters);
 #endif
 
+#if AMU_SNAPSHOT
+#if !defined(PLAT_AMU_SNAPSHOT_BASE) || !defined(PLAT_AMU_SNAPSHOT_SIZE)
+# error "AMU_SNAPSHOT requires PLAT_AMU_SNAPSHOT_BASE and PLAT_AMU_SNAPSHOT_SIZE"
+#endif
+
+CASSERT(AMU_SNAPSHOT_SIZE <= PLAT_AMU_SNAPSHOT_SIZE,
+	assert_amu_snapshot_region_too_small);
+CASSERT(AMU_SNAPSHOT_GROUP0_COUNTERS <= AMU_GROUP0_MAX_COUNTERS,
+	assert_amu_snapshot_group0_counters);
+CASSERT(AMU_SNAPSHOT_GROUP1_COUNTERS <= AMU_GROUP1_MAX_COUNTERS,
+	assert_amu_snapshot_group1_counters);
+
+/* Set once the primary core has cleared the snapshots at cold boot */
+static bool amu_snapshot_ready;
+
+/*
+ * Publish the given counters as the snapshot of the core at `core_pos`. Only
+ * that core writes its snapshot, so the sequence count needs no atomics.
+ */
+static void amu_snapshot_publish(unsigned int core_pos, uint32_t event,
+		const uint64_t *group0_cnts, uint64_t group0_num,
+		const uint64_t *group1_cnts, uint64_t group1_num)
+{
+	struct amu_snapshot *snap =
+		&((struct amu_snapshot *)PLAT_AMU_SNAPSHOT_BASE)[core_pos];
+	unsigned int i;
+
+	group0_num = MIN(group0_num, (uint64_t)AMU_SNAPSHOT_GROUP0_COUNTERS);
+	group1_num = MIN(group1_num, (uint64_t)AMU_SNAPSHOT_GROUP1_COUNTERS);
+
+	/* Readers retry while the sequence count is odd */
+	snap->seq++;
+	dmbishst();
+
+	snap->timestamp = read_cntpct_el0();
+	snap->event = event;
+	snap->group0_num = (uint16_t)group0_num;
+	snap->group1_num = (uint16_t)group1_num;
+
+	for (i = 0U; i < group0_num; i++) {
+		snap->group0_cnts[i] = group0_cnts[i];
+	}
+
+	for (i = 0U; i < group1_num; i++) {
+		snap->group1_cnts[i] = group1_cnts[i];
+	}
+
+	dmbishst();
+	snap->seq++;
+}
+#endif /* AMU_SNAPSHOT */
+
 static inline __unused uint64_t read_hcr_el2_amvoffen(void)
 {
 	return (read_hcr_el2() & HCR_AMVOFFEN_BIT) >>
@@ -208,6 +261,17 @@ void amu_init_el3(void)
 	uint64_t group0_en_mask = (1 << (group0_impl_ctr)) - 1U;
 	uint64_t num_ctr_groups = read_amcfgr_el0_ncg();
 
+#if AMU_SNAPSHOT
+	if (!amu_snapshot_ready) {
+		/*
+		 * The first call is on the primary core at cold boot, before
+		 * the normal world runs: make every snapshot consistent.
+		 */
+		zeromem((void *)PLAT_AMU_SNAPSHOT_BASE, AMU_SNAPSHOT_SIZE);
+		amu_snapshot_ready = true;
+	}
+#endif
+
 	/* Enable all architected counters by default */
 	write_amcntenset0_el0_px(group0_en_mask);
 
@@ -279,22 +343,22 @@ void amu_init_el2_unused(void)
 	}
 }
 
-/* Read the group 0 counter identified by the given `idx`. */
-static uint64_t amu_group0_cnt_read(unsigned int idx)
+/* Read the first `num` group 0 counters into `cnts` */
+static void amu_group0_cnts_read(uint64_t *cnts, uint64_t num)
 {
 	assert(is_feat_amu_supported());
-	assert(idx < read_amcgcr_el0_cg0nc());
+	assert(num <= read_amcgcr_el0_cg0nc());
 
-	return amu_group0_cnt_read_internal(idx);
+	amu_group0_cnts_read_internal(cnts, (unsigned int)num);
 }
 
-/* Write the group 0 counter identified by the given `idx` with `val` */
-static void amu_group0_cnt_write(unsigned  int idx, uint64_t val)
+/* Write the first `num` group 0 counters with the values in `cnts` */
+static void amu_group0_cnts_write(const uint64_t *cnts, uint64_t num)
 {
 	assert(is_feat_amu_supported());
-	assert(idx < read_amcgcr_el0_cg0nc());
+	assert(num <= read_amcgcr_el0_cg0nc());
 
-	amu_group0_cnt_write_internal(idx, val);
+	amu_group0_cnts_write_internal(cnts, (unsigned int)num);
 	isb();
 }
 
@@ -355,24 +419,24 @@ static void amu_group0_voffset_write(unsigned int idx, uint64_t val)
 }
 
 #if ENABLE_AMU_AUXILIARY_COUNTERS
-/* Read the group 1 counter identified by the given `idx` */
-static uint64_t amu_group1_cnt_read(unsigned int idx)
+/* Read the first `num` group 1 counters into `cnts` */
+static void amu_group1_cnts_read(uint64_t *cnts, uint64_t num)
 {
 	assert(is_feat_amu_supported());
 	assert(amu_group1_supported());
-	assert(idx < read_amcgcr_el0_cg1nc());
+	assert(num <= read_amcgcr_el0_cg1nc());
 
-	return amu_group1_cnt_read_internal(idx);
+	amu_group1_cnts_read_internal(cnts, (unsigned int)num);
 }
 
-/* Write the group 1 counter identified by the given `idx` with `val` */
-static void amu_group1_cnt_write(unsigned int idx, uint64_t val)
+/* Write the first `num` group 1 counters with the values in `cnts` */
+static void amu_group1_cnts_write(const uint64_t *cnts, uint64_t num)
 {
 	assert(is_feat_amu_supported());
 	assert(amu_group1_supported());
-	assert(idx < read_amcgcr_el0_cg1nc());
+	assert(num <= read_amcgcr_el0_cg1nc());
 
-	amu_group1_cnt_write_internal(idx, val);
+	amu_group1_cnts_write_internal(cnts, (unsigned int)num);
 	isb();
 }
 
@@ -462,13 +526,11 @@ static void *amu_context_save(const void *arg)
 
 	isb(); /* Ensure counters have been stopped */
 
-	for (i = 0U; i < amcgcr_el0_cg0nc; i++) {
-		ctx->group0_cnts[i] = amu_group0_cnt_read(i);
-	}
+	amu_group0_cnts_read(ctx->group0_cnts, amcgcr_el0_cg0nc);
 
 #if ENABLE_AMU_AUXILIARY_COUNTERS
-	for (i = 0U; i < amcgcr_el0_cg1nc; i++) {
-		ctx->group1_cnts[i] = amu_group1_cnt_read(i);
+	if (amcgcr_el0_cg1nc > 0U) {
+		amu_group1_cnts_read(ctx->group1_cnts, amcgcr_el0_cg1nc);
 	}
 #endif
 
@@ -496,6 +558,17 @@ static void *amu_context_save(const void *arg)
 #endif
 	}
 
+#if AMU_SNAPSHOT
+#if ENABLE_AMU_AUXILIARY_COUNTERS
+	amu_snapshot_publish(core_pos, AMU_SNAPSHOT_EVENT_PWRDOWN,
+			     ctx->group0_cnts, amcgcr_el0_cg0nc,
+			     ctx->group1_cnts, amcgcr_el0_cg1nc);
+#else
+	amu_snapshot_publish(core_pos, AMU_SNAPSHOT_EVENT_PWRDOWN,
+			     ctx->group0_cnts, amcgcr_el0_cg0nc, NULL, 0U);
+#endif
+#endif /* AMU_SNAPSHOT */
+
 	return (void *)0;
 }
 
@@ -539,13 +612,11 @@ static void *amu_context_restore(const void *arg)
 	 * Restore the counter values from the local context.
 	 */
 
-	for (i = 0U; i < amcgcr_el0_cg0nc; i++) {
-		amu_group0_cnt_write(i, ctx->group0_cnts[i]);
-	}
+	amu_group0_cnts_write(ctx->group0_cnts, amcgcr_el0_cg0nc);
 
 #if ENABLE_AMU_AUXILIARY_COUNTERS
-	for (i = 0U; i < amcgcr_el0_cg1nc; i++) {
-		amu_group1_cnt_write(i, ctx->group1_cnts[i]);
+	if (amcgcr_el0_cg1nc > 0U) {
+		amu_group1_cnts_write(ctx->group1_cnts, amcgcr_el0_cg1nc);
 	}
 #endif
 
@@ -585,6 +656,17 @@ static void *amu_context_restore(const void *arg)
 	}
 #endif
 
+#if AMU_SNAPSHOT
+#if ENABLE_AMU_AUXILIARY_COUNTERS
+	amu_snapshot_publish(core_pos, AMU_SNAPSHOT_EVENT_PWRUP,
+			     ctx->group0_cnts, amcgcr_el0_cg0nc,
+			     ctx->group1_cnts, amcgcr_el0_cg1nc);
+#else
+	amu_snapshot_publish(core_pos, AMU_SNAPSHOT_EVENT_PWRUP,
+			     ctx->group0_cnts, amcgcr_el0_cg0nc, NULL, 0U);
+#endif
+#endif /* AMU_SNAPSHOT */
+
 #if ENABLE_MPMM
 	mpmm_enable();
 #endif
@@ -594,3 +676,42 @@ static void *amu_context_restore(const void *arg)
 
 SUBSCRIBE_TO_EVENT(psci_suspend_pwrdown_start, amu_context_save);
 SUBSCRIBE_TO_EVENT(psci_suspend_pwrdown_finish, amu_context_restore);
+
+#if AMU_SNAPSHOT
+/* Publish the counters of a core that has just been turned on */
+static void *amu_snapshot_cpu_on(const void *arg)
+{
+	uint64_t group0_cnts[AMU_GROUP0_MAX_COUNTERS];
+	uint64_t amcgcr_el0_cg0nc;
+#if ENABLE_AMU_AUXILIARY_COUNTERS
+	uint64_t group1_cnts[AMU_GROUP1_MAX_COUNTERS];
+	uint64_t amcgcr_el0_cg1nc;
+#endif
+
+	if (!is_feat_amu_supported()) {
+		return (void *)0;
+	}
+
+	amcgcr_el0_cg0nc = read_amcgcr_el0_cg0nc();
+	amu_group0_cnts_read(group0_cnts, amcgcr_el0_cg0nc);
+
+#if ENABLE_AMU_AUXILIARY_COUNTERS
+	amcgcr_el0_cg1nc = (read_amcfgr_el0_ncg() > 0U) ?
+		read_amcgcr_el0_cg1nc() : 0U;
+	if (amcgcr_el0_cg1nc > 0U) {
+		amu_group1_cnts_read(group1_cnts, amcgcr_el0_cg1nc);
+	}
+
+	amu_snapshot_publish(plat_my_core_pos(), AMU_SNAPSHOT_EVENT_CPU_ON,
+			     group0_cnts, amcgcr_el0_cg0nc,
+			     group1_cnts, amcgcr_el0_cg1nc);
+#else
+	amu_snapshot_publish(plat_my_core_pos(), AMU_SNAPSHOT_EVENT_CPU_ON,
+			     group0_cnts, amcgcr_el0_cg0nc, NULL, 0U);
+#endif
+
+	return (void *)0;
+}
+
+SUBSCRIBE_TO_EVENT(psci_cpu_on_finish, amu_snapshot_cpu_on);
+#endif /* AMU_SNAPSHOT */
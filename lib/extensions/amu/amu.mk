@@ -15,6 +15,15 @@ ifneq (${ENABLE_AMU_AUXILIARY_COUNTERS},0)
         endif
 endif
 
+ifneq (${AMU_SNAPSHOT},0)
+        ifeq (${ENABLE_FEAT_AMU},0)
+                $(error AMU snapshots (`AMU_SNAPSHOT`) require AMU support (`ENABLE_FEAT_AMU`))
+        endif
+        ifneq (${ARCH},aarch64)
+                $(error AMU snapshots (`AMU_SNAPSHOT`) are only supported for AArch64)
+        endif
+endif
+
 ifneq (${ENABLE_AMU_FCONF},0)
         ifeq (${ENABLE_AMU_AUXILIARY_COUNTERS},0)
                 $(error AMU FCONF support (`ENABLE_AMU_FCONF`) is not necessary when auxiliary counter support (`ENABLE_AMU_AUXILIARY_COUNTERS`) is disabled)
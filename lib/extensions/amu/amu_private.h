@@ -28,6 +28,12 @@ void amu_group1_cnt_write_internal(unsigned int idx, uint64_t val);
 void amu_group1_set_evtype_internal(unsigned int idx, unsigned int val);
 
 #if __aarch64__
+void amu_group0_cnts_read_internal(uint64_t *cnts, unsigned int num);
+void amu_group0_cnts_write_internal(const uint64_t *cnts, unsigned int num);
+
+void amu_group1_cnts_read_internal(uint64_t *cnts, unsigned int num);
+void amu_group1_cnts_write_internal(const uint64_t *cnts, unsigned int num);
+
 uint64_t amu_group0_voffset_read_internal(unsigned int idx);
 void amu_group0_voffset_write_internal(unsigned int idx, uint64_t val);
 
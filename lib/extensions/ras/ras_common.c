@@ -5,20 +5,45 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <errno.h>
 #include <stdbool.h>
 
 #include <arch_helpers.h>
 #include <bl31/ea_handle.h>
 #include <bl31/ehf.h>
 #include <common/debug.h>
+#include <common/runtime_svc.h>
 #include <lib/extensions/ras.h>
 #include <lib/extensions/ras_arch.h>
+#include <lib/spinlock.h>
 #include <plat/common/platform.h>
+#include <smccc_helpers.h>
 
 #ifndef PLAT_RAS_PRI
 # error Platform must define RAS priority value
 #endif
 
+/*
+ * Number of interrupt numbers, starting from the lowest registered RAS
+ * interrupt, that are looked up directly rather than by binary search.
+ */
+#ifndef PLAT_RAS_INTR_LUT_SIZE
+# define PLAT_RAS_INTR_LUT_SIZE	U(128)
+#endif
+
+#if PLAT_RAS_INTR_LUT_SIZE
+/*
+ * Index into ras_interrupt_mappings, plus one, of the interrupt numbered
+ * ras_intr_lut_base + n; zero if no such interrupt is registered.
+ */
+static uint16_t ras_intr_lut[PLAT_RAS_INTR_LUT_SIZE];
+static unsigned int ras_intr_lut_base;
+#endif
+
+#if RAS_ERR_STATS
+static spinlock_t ras_stats_lock;
+#endif
+
 /*
  * Function to convert architecturally-defined primary error code SERR,
  * bits[7:0] from ERR<n>STATUS to its corresponding error string.
@@ -60,6 +85,131 @@ const char *ras_serr_to_str(unsigned int serr)
 	return str[serr];
 }
 
+#if RAS_ERR_STATS
+static bool ras_err_is_std(const struct err_record_info *info)
+{
+	return (info->probe == ras_err_ser_probe_memmap) ||
+		(info->probe == ras_err_ser_probe_sysreg);
+}
+
+/*
+ * Account for an error that a record group has been probed to be in. Returns
+ * true if it is a corrected error beyond the group's rate limit, in which case
+ * it has been cleared and must not be passed on to the group handler.
+ *
+ * Corrected errors can only be told apart, and cleared, for groups using the
+ * standard probes: for those, the record in error is identified by the probe
+ * data, and is still selected in the System register case.
+ */
+static bool ras_err_account(struct err_record_info *info, int probe_data)
+{
+	struct ras_err_stats *stats = &info->stats;
+	uint64_t status = 0ULL;
+	bool corrected = false, throttle = false;
+
+	if (ras_err_is_std(info)) {
+		if (info->access == ERR_ACCESS_MEMMAP) {
+			status = ser_get_status(info->memmap.base_addr,
+					(unsigned int)probe_data);
+		} else {
+			status = read_erxstatus_el1();
+		}
+
+		corrected = (ERR_STATUS_GET_FIELD(status, CE) != 0U) &&
+			(ERR_STATUS_GET_FIELD(status, UE) == 0U) &&
+			(ERR_STATUS_GET_FIELD(status, DE) == 0U);
+	}
+
+	spin_lock(&ras_stats_lock);
+
+	if (corrected) {
+		stats->corrected++;
+#if RAS_CE_RATE_LIMIT
+		uint64_t now = read_cntpct_el0();
+
+		/* Allow RAS_CE_RATE_LIMIT corrected errors per second */
+		if ((now - stats->window_start) >= read_cntfrq_el0()) {
+			stats->window_start = now;
+			stats->window_count = 0U;
+		}
+
+		if (stats->window_count >= RAS_CE_RATE_LIMIT) {
+			throttle = true;
+		} else {
+			stats->window_count++;
+		}
+#endif
+	}
+
+	if (throttle) {
+		stats->throttled++;
+	} else {
+		stats->handled++;
+	}
+
+	spin_unlock(&ras_stats_lock);
+
+	if (throttle) {
+		/* Status fields are write-one-to-clear */
+		if (info->access == ERR_ACCESS_MEMMAP) {
+			ser_set_status(info->memmap.base_addr,
+					(unsigned int)probe_data, status);
+		} else {
+			write_erxstatus_el1(status);
+		}
+	}
+
+	return throttle;
+}
+
+/*
+ * Copy out the counters of a record group. Returns 0 on success, or -EINVAL
+ * if there's no such group.
+ */
+int ras_get_err_stats(unsigned int group, struct ras_err_stats *stats)
+{
+	if (group >= err_record_mappings.num_err_records) {
+		return -EINVAL;
+	}
+
+	spin_lock(&ras_stats_lock);
+	*stats = err_record_mappings.err_records[group].stats;
+	spin_unlock(&ras_stats_lock);
+
+	return 0;
+}
+
+uintptr_t ras_smc_handler(unsigned int smc_fid, u_register_t x1,
+		u_register_t x2, u_register_t x3, u_register_t x4,
+		void *cookie, void *handle, u_register_t flags)
+{
+	struct ras_err_stats stats;
+
+	assert(smc_fid == RAS_SMC_GET_ERR_STATS);
+
+	if ((x1 > UINT32_MAX) ||
+	    (ras_get_err_stats((unsigned int)x1, &stats) != 0)) {
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	SMC_RET5(handle, SMC_OK, stats.handled, stats.corrected,
+		 stats.throttled, err_record_mappings.num_err_records);
+}
+#endif /* RAS_ERR_STATS */
+
+/* Pass an error that a record group has been probed to be in to its handler */
+static int ras_err_dispatch(struct err_record_info *info, int probe_data,
+		const struct err_handler_data *err_data)
+{
+#if RAS_ERR_STATS
+	if (ras_err_account(info, probe_data)) {
+		return 0;
+	}
+#endif
+
+	return info->handler(info, probe_data, err_data);
+}
+
 /* Handler that receives External Aborts on RAS-capable systems */
 int ras_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 		void *handle, uint64_t flags)
@@ -88,7 +238,7 @@ int ras_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 				break;
 
 			/* Handle error */
-			ret = info->handler(info, probe_data, &err_data);
+			ret = ras_err_dispatch(info, probe_data, &err_data);
 			if (ret != 0)
 				return ret;
 
@@ -116,6 +266,71 @@ static void assert_interrupts_sorted(void)
 }
 #endif
 
+/* Locate the mapping of a RAS interrupt; NULL if it's not registered */
+static struct ras_interrupt *ras_find_interrupt(uint32_t intr_raw)
+{
+	struct ras_interrupt *ras_inrs = ras_interrupt_mappings.intrs;
+	int start, end, mid;
+
+#if PLAT_RAS_INTR_LUT_SIZE
+	/* Interrupts below the base wrap around to out-of-range slots */
+	unsigned int slot = intr_raw - ras_intr_lut_base;
+
+	if (slot < PLAT_RAS_INTR_LUT_SIZE) {
+		if (ras_intr_lut[slot] == 0U) {
+			return NULL;
+		}
+
+		return &ras_inrs[ras_intr_lut[slot] - 1U];
+	}
+#endif
+
+	start = 0;
+	end = (int)ras_interrupt_mappings.num_intrs - 1;
+	while (start <= end) {
+		mid = ((end + start) / 2);
+		if (intr_raw == ras_inrs[mid].intr_number) {
+			return &ras_inrs[mid];
+		} else if (intr_raw < ras_inrs[mid].intr_number) {
+			/* Move left */
+			end = mid - 1;
+		} else {
+			/* Move right */
+			start = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+#if PLAT_RAS_INTR_LUT_SIZE
+/*
+ * Fill the direct-indexed table with the interrupts registered in the window
+ * starting at the lowest one. The mappings are sorted, so the walk can stop at
+ * the first interrupt beyond the window.
+ */
+static void __init ras_build_intr_lut(void)
+{
+	struct ras_interrupt *ras_inrs = ras_interrupt_mappings.intrs;
+	unsigned int i, slot;
+
+	if (ras_interrupt_mappings.num_intrs == 0UL)
+		return;
+
+	/* Entries hold a 16-bit index plus one */
+	assert(ras_interrupt_mappings.num_intrs < UINT16_MAX);
+
+	ras_intr_lut_base = ras_inrs[0].intr_number;
+	for (i = 0; i < ras_interrupt_mappings.num_intrs; i++) {
+		slot = ras_inrs[i].intr_number - ras_intr_lut_base;
+		if (slot >= PLAT_RAS_INTR_LUT_SIZE)
+			break;
+
+		ras_intr_lut[slot] = (uint16_t)(i + 1U);
+	}
+}
+#endif
+
 /*
  * Given an RAS interrupt number, locate the registered handler and call it. If
  * no handler was found for the interrupt number, this function panics.
@@ -123,10 +338,9 @@ static void assert_interrupts_sorted(void)
 static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 		void *handle, void *cookie)
 {
-	struct ras_interrupt *ras_inrs = ras_interrupt_mappings.intrs;
-	struct ras_interrupt *selected = NULL;
+	struct ras_interrupt *selected;
 	int probe_data = 0;
-	int start, end, mid, ret __unused;
+	int ret __unused;
 
 	const struct err_handler_data err_data = {
 		.version = ERR_HANDLER_VERSION,
@@ -138,21 +352,7 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 
 	assert(ras_interrupt_mappings.num_intrs > 0UL);
 
-	start = 0;
-	end = (int)ras_interrupt_mappings.num_intrs - 1;
-	while (start <= end) {
-		mid = ((end + start) / 2);
-		if (intr_raw == ras_inrs[mid].intr_number) {
-			selected = &ras_inrs[mid];
-			break;
-		} else if (intr_raw < ras_inrs[mid].intr_number) {
-			/* Move left */
-			end = mid - 1;
-		} else {
-			/* Move right */
-			start = mid + 1;
-		}
-	}
+	selected = ras_find_interrupt(intr_raw);
 
 	if (selected == NULL) {
 		ERROR("RAS interrupt %u has no handler!\n", intr_raw);
@@ -166,8 +366,7 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 
 	/* Call error handler for the record group */
 	assert(selected->err_record->handler != NULL);
-	(void) selected->err_record->handler(selected->err_record, probe_data,
-			&err_data);
+	(void) ras_err_dispatch(selected->err_record, probe_data, &err_data);
 
 	return 0;
 }
@@ -179,6 +378,10 @@ void __init ras_init(void)
 	assert_interrupts_sorted();
 #endif
 
+#if PLAT_RAS_INTR_LUT_SIZE
+	ras_build_intr_lut();
+#endif
+
 	/* Register RAS priority handler */
 	ehf_register_priority_handler(PLAT_RAS_PRI, ras_interrupt_handler);
 }
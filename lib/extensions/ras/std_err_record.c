@@ -4,9 +4,17 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdbool.h>
+
+#include <arch.h>
+#include <arch_helpers.h>
+#include <lib/extensions/ras.h>
 #include <lib/extensions/ras_arch.h>
 #include <lib/utils_def.h>
 
+/* Number of error records whose status a group status register summarises */
+#define SER_GROUP_RECORDS	64U
+
 /*
  * Probe for error in memory-mapped registers containing error records
  * implemented Standard Error Record format. Upon detecting an error, set probe
@@ -26,7 +34,7 @@ int ser_probe_memmap(uintptr_t base, unsigned int size_num_k, int *probe_data)
 		(mmio_read_32(ERR_DEVID(base, size_num_k)) & ERR_DEVID_MASK);
 
 	/* A group register shows error status for 2^6 error records */
-	num_group_regs = (num_records >> 6U) + 1U;
+	num_group_regs = div_round_up(num_records, SER_GROUP_RECORDS);
 
 	/* Iterate through group registers to find a record in error */
 	for (i = 0; i < num_group_regs; i++) {
@@ -44,6 +52,57 @@ int ser_probe_memmap(uintptr_t base, unsigned int size_num_k, int *probe_data)
 	return 0;
 }
 
+/*
+ * FEAT_RASv2 adds ERXGSR_EL1, which summarises the status of the 64 System
+ * register error records around the one selected by ERRSELR_EL1.
+ */
+static bool ser_sys_has_group_status(void)
+{
+	return ((read_id_aa64pfr0_el1() >> ID_AA64PFR0_RAS_SHIFT) &
+		ID_AA64PFR0_RAS_MASK) >= ID_AA64PFR0_RAS_V2;
+}
+
+/*
+ * Scan records [idx_start, idx_start + num_idx) a group at a time, only
+ * selecting the records that ERXGSR_EL1 reports as being in error.
+ */
+static int ser_probe_sysreg_grouped(unsigned int idx_start,
+		unsigned int num_idx, int *probe_data)
+{
+	unsigned int idx, grp, next, end = idx_start + num_idx;
+	uint64_t gsr;
+
+	for (idx = idx_start; idx < end; idx = next) {
+		grp = idx & ~(SER_GROUP_RECORDS - 1U);
+		next = MIN(grp + SER_GROUP_RECORDS, end);
+
+		write_errselr_el1(idx);
+		isb();
+
+		/* Ignore records of the group outside the requested range */
+		gsr = read_erxgsr_el1() & GENMASK_64(next - grp - 1U, idx - grp);
+
+		while (gsr != 0ULL) {
+			unsigned int rec = grp + __builtin_ctzll(gsr);
+
+			/* Leave the record in error selected for the handler */
+			write_errselr_el1(rec);
+			isb();
+
+			if (ERR_STATUS_GET_FIELD(read_erxstatus_el1(), V) != 0U) {
+				if (probe_data != NULL)
+					*probe_data = (int) (rec - idx_start);
+				return 1;
+			}
+
+			/* The error was cleared since ERXGSR_EL1 was read */
+			gsr &= gsr - 1ULL;
+		}
+	}
+
+	return 0;
+}
+
 /*
  * Probe for error in System Registers where error records are implemented in
  * Standard Error Record format. Upon detecting an error, set probe data to the
@@ -60,9 +119,17 @@ int ser_probe_sysreg(unsigned int idx_start, unsigned int num_idx, int *probe_da
 	assert(check_u32_overflow(idx_start, num_idx) == 0);
 	assert((idx_start + num_idx - 1U) < max_idx);
 
+	if (ser_sys_has_group_status())
+		return ser_probe_sysreg_grouped(idx_start, num_idx, probe_data);
+
 	for (i = 0; i < num_idx; i++) {
-		/* Select the error record */
-		ser_sys_select_record(idx_start + i);
+		/*
+		 * Select the error record. The range was checked against
+		 * ERRIDR_EL1 above, so there's no need to read it for every
+		 * record as ser_sys_select_record() does.
+		 */
+		write_errselr_el1(idx_start + i);
+		isb();
 
 		/* Retrieve status register from the error record */
 		status = read_erxstatus_el1();
@@ -77,3 +144,25 @@ int ser_probe_sysreg(unsigned int idx_start, unsigned int num_idx, int *probe_da
 
 	return 0;
 }
+
+/*
+ * Helper functions to probe memory-mapped and system registers implemented in
+ * Standard Error Record format
+ */
+int ras_err_ser_probe_memmap(const struct err_record_info *info,
+		int *probe_data)
+{
+	assert(info->version == ERR_HANDLER_VERSION);
+
+	return ser_probe_memmap(info->memmap.base_addr, info->memmap.size_num_k,
+		probe_data);
+}
+
+int ras_err_ser_probe_sysreg(const struct err_record_info *info,
+		int *probe_data)
+{
+	assert(info->version == ERR_HANDLER_VERSION);
+
+	return ser_probe_sysreg(info->sysreg.idx_start, info->sysreg.num_idx,
+			probe_data);
+}
@@ -59,6 +59,12 @@ void fconf_populate(const char *config_type, uintptr_t config)
 
 	INFO("FCONF: Reading %s firmware configuration file from: 0x%lx\n", config_type, config);
 
+	/*
+	 * Index the DTB, if enabled, so that the populators do not have to
+	 * scan it for every node and property they read.
+	 */
+	(void)fdtw_index_build((const void *)config);
+
 	/* Go through all registered populate functions */
 	IMPORT_SYM(struct fconf_populator *, __FCONF_POPULATOR_START__, start);
 	IMPORT_SYM(struct fconf_populator *, __FCONF_POPULATOR_END__, end);
@@ -75,4 +81,7 @@ void fconf_populate(const char *config_type, uintptr_t config)
 			}
 		}
 	}
+
+	/* The DTB may be modified once populated */
+	fdtw_index_drop((const void *)config);
 }
@@ -47,7 +47,7 @@ static int fconf_populate_amu_cpu_amu(const void *fdt, int parent,
 			break;
 		}
 
-		value = fdt_getprop(fdt, node, "enable-at-el3", &len);
+		value = fdtw_getprop(fdt, node, "enable-at-el3", &len);
 		if ((value == NULL) && (len != -FDT_ERR_NOTFOUND)) {
 			break;
 		}
@@ -87,7 +87,7 @@ static int fconf_populate_amu_cpu(const void *fdt, int node, uintptr_t mpidr)
 		return ret;
 	}
 
-	node = fdt_node_offset_by_phandle(fdt, amu_phandle);
+	node = fdtw_node_offset_by_phandle(fdt, amu_phandle);
 	if (node < 0) {
 		return node;
 	}
@@ -198,7 +198,7 @@ static int get_oid(const void *dtb, int node, const char *prop, char **oid)
 		return rc;
 	}
 
-	node = fdt_node_offset_by_phandle(dtb, phandle);
+	node = fdtw_node_offset_by_phandle(dtb, phandle);
 	if (node < 0) {
 		return node;
 	}
@@ -297,7 +297,7 @@ static int get_parent_img_id(const void *dtb, int node,
 		return err;
 	}
 
-	node = fdt_node_offset_by_phandle(dtb, phandle);
+	node = fdtw_node_offset_by_phandle(dtb, phandle);
 	if (node < 0) {
 		ERROR("FCONF: Failed to locate node using its phandle\n");
 		return node;
@@ -333,7 +333,7 @@ static int set_desc_data(const void *dtb, int node, img_type_t type)
 		return rc;
 	}
 
-	if (fdt_getprop(dtb, node, "root-certificate",
+	if (fdtw_getprop(dtb, node, "root-certificate",
 					NULL) != NULL) {
 		root_certificate = true;
 	}
@@ -385,7 +385,7 @@ static int populate_manifest_descs(const void *dtb)
 	 */
 	const char *compatible_str = "arm, cert-descs";
 
-	node = fdt_node_offset_by_compatible(dtb, -1, compatible_str);
+	node = fdtw_node_offset_by_compatible(dtb, -1, compatible_str);
 	if (node < 0) {
 		ERROR("FCONF: Can't find %s compatible in node\n",
 			compatible_str);
@@ -420,7 +420,7 @@ static int populate_image_descs(const void *dtb)
 	 */
 	const char *compatible_str = "arm, img-descs";
 
-	node = fdt_node_offset_by_compatible(dtb, -1, compatible_str);
+	node = fdtw_node_offset_by_compatible(dtb, -1, compatible_str);
 	if (node < 0) {
 		ERROR("FCONF: Can't find %s compatible in node\n",
 			compatible_str);
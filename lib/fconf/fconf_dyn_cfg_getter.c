@@ -97,7 +97,7 @@ int fconf_populate_dtb_registry(uintptr_t config)
 
 	/* Find the node offset point to "fconf,dyn_cfg-dtb_registry" compatible property */
 	const char *compatible_str = "fconf,dyn_cfg-dtb_registry";
-	node = fdt_node_offset_by_compatible(dtb, -1, compatible_str);
+	node = fdtw_node_offset_by_compatible(dtb, -1, compatible_str);
 	if (node < 0) {
 		ERROR("FCONF: Can't find %s compatible in dtb\n", compatible_str);
 		return node;
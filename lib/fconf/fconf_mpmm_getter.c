@@ -38,7 +38,7 @@ static int fconf_populate_mpmm_cpu(const void *fdt, int off, uintptr_t mpidr)
 
 	core = &fconf_mpmm_topology.cores[core_pos];
 
-	fdt_getprop(fdt, off, "supports-mpmm", &len);
+	fdtw_getprop(fdt, off, "supports-mpmm", &len);
 	if (len >= 0) {
 		core->supported = true;
 		ret = 0;
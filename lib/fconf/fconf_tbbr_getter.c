@@ -25,7 +25,7 @@ int fconf_populate_tbbr_dyn_config(uintptr_t config)
 
 	/* Assert the node offset point to "arm,tb_fw" compatible property */
 	const char *compatible_str = "arm,tb_fw";
-	node = fdt_node_offset_by_compatible(dtb, -1, compatible_str);
+	node = fdtw_node_offset_by_compatible(dtb, -1, compatible_str);
 	if (node < 0) {
 		ERROR("FCONF: Can't find `%s` compatible in dtb\n",
 						compatible_str);
@@ -143,7 +143,17 @@ typedef struct non_cpu_pwr_domain_node {
 
 	/* For indexing the psci_lock array*/
 	uint16_t lock_index;
+#if PSCI_CACHE_LINE_ALIGN && !USE_COHERENT_MEM
+	/*
+	 * The nodes are updated by the last cpu of their domain to enter or
+	 * exit a low power state, so give each one its own cache line to avoid
+	 * false sharing between domains. With coherent memory they are mapped
+	 * non-cacheable and are left packed.
+	 */
+} __aligned(CACHE_WRITEBACK_GRANULE) non_cpu_pd_node_t;
+#else
 } non_cpu_pd_node_t;
+#endif
 
 typedef struct cpu_pwr_domain_node {
 	u_register_t mpidr;
@@ -161,7 +171,16 @@ typedef struct cpu_pwr_domain_node {
 	 * when multiple CPUs try to turn ON the same target CPU.
 	 */
 	spinlock_t cpu_lock;
+#if PSCI_CACHE_LINE_ALIGN
+	/*
+	 * The cpu_lock is taken by the callers of CPU_ON for this cpu, so each
+	 * node has its own cache line to avoid disturbing the neighbouring
+	 * cpus.
+	 */
+} __aligned(CACHE_WRITEBACK_GRANULE) cpu_pd_node_t;
+#else
 } cpu_pd_node_t;
+#endif
 
 #if PSCI_OS_INIT_MODE
 /*******************************************************************************
@@ -23,6 +23,18 @@ typedef struct psci_stat {
 	u_register_t count;
 } psci_stat_t;
 
+/*
+ * The CPU stats are updated by each CPU on wake-up. With PSCI_CACHE_LINE_ALIGN,
+ * the stats of each CPU get their own cache line.
+ */
+typedef struct psci_pcpu_stat {
+	psci_stat_t stat[PLAT_MAX_PWR_LVL_STATES];
+#if PSCI_CACHE_LINE_ALIGN
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_pcpu_stat_t;
+#else
+} psci_pcpu_stat_t;
+#endif
+
 /*
  * Following is used to keep track of the last cpu
  * that goes to power down in non cpu power domains.
@@ -34,8 +46,7 @@ static int last_cpu_in_non_cpu_pd[PSCI_NUM_NON_CPU_PWR_DOMAINS] = {
  * Following are used to store PSCI STAT values for
  * CPU and non CPU power domains.
  */
-static psci_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT]
-				[PLAT_MAX_PWR_LVL_STATES];
+static psci_pcpu_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT];
 static psci_stat_t psci_non_cpu_stat[PSCI_NUM_NON_CPU_PWR_DOMAINS]
 				[PLAT_MAX_PWR_LVL_STATES];
 
@@ -127,8 +138,8 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 	    state_info, cpu_idx);
 
 	/* Update CPU stats. */
-	psci_cpu_stat[cpu_idx][stat_idx].residency += residency;
-	psci_cpu_stat[cpu_idx][stat_idx].count++;
+	psci_cpu_stat[cpu_idx].stat[stat_idx].residency += residency;
+	psci_cpu_stat[cpu_idx].stat[stat_idx].count++;
 
 	/*
 	 * Check what power domains above CPU were off
@@ -215,7 +226,7 @@ static int psci_get_stat(u_register_t target_cpu, unsigned int power_state,
 		*psci_stat = psci_non_cpu_stat[parent_idx][stat_idx];
 	} else {
 		/* Get the cpu power domain stats */
-		*psci_stat = psci_cpu_stat[target_idx][stat_idx];
+		*psci_stat = psci_cpu_stat[target_idx].stat[stat_idx];
 	}
 
 	return PSCI_E_SUCCESS;
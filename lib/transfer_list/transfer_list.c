@@ -12,6 +12,94 @@
 #include <lib/transfer_list.h>
 #include <lib/utils_def.h>
 
+#if TRANSFER_LIST_INDEX_SIZE
+/*
+ * Cache of the offsets of the entries found by transfer_list_find(). It is
+ * invalidated for a transfer list whenever one of its entries is moved or
+ * removed.
+ */
+static struct transfer_list_index {
+	const struct transfer_list_header *tl;
+	uint32_t offset;
+	uint16_t tag_id;
+} tl_index[TRANSFER_LIST_INDEX_SIZE];
+
+static unsigned int tl_index_next;
+
+static void index_invalidate(const struct transfer_list_header *tl)
+{
+	unsigned int i;
+
+	for (i = 0U; i < TRANSFER_LIST_INDEX_SIZE; i++) {
+		if (tl_index[i].tl == tl) {
+			tl_index[i].tl = NULL;
+		}
+	}
+}
+#else
+static inline void index_invalidate(const struct transfer_list_header *tl)
+{
+}
+#endif /* TRANSFER_LIST_INDEX_SIZE */
+
+/*
+ * Used to read the transfer list one word at a time without breaking the
+ * strict aliasing rules.
+ */
+typedef uint64_t __attribute__((__may_alias__)) tl_word_t;
+
+/*******************************************************************************
+ * Calculate the byte sum of a memory range, one word at a time where possible
+ * Return byte sum of the memory range
+ ******************************************************************************/
+static uint8_t sum_bytes(const void *addr, size_t size)
+{
+	const uint8_t *b = addr;
+	uint8_t cs = 0;
+
+	while (size && !is_aligned((uintptr_t)b, sizeof(tl_word_t))) {
+		cs += *b++;
+		size--;
+	}
+
+	while (size >= sizeof(tl_word_t)) {
+		const tl_word_t *w = (const tl_word_t *)b;
+		// at most 128 words so that the 16-bit lanes can't overflow
+		size_t n = MIN(size / sizeof(tl_word_t), (size_t)128);
+		uint64_t lanes = 0;
+		size_t i;
+
+		// add the even and odd bytes of each word in 16-bit lanes
+		for (i = 0; i < n; i++) {
+			lanes += w[i] & 0x00ff00ff00ff00ffULL;
+			lanes += (w[i] >> 8) & 0x00ff00ff00ff00ffULL;
+		}
+		cs += (uint8_t)((lanes & 0xffffU) + ((lanes >> 16) & 0xffffU) +
+				((lanes >> 32) & 0xffffU) + (lanes >> 48));
+
+		b += n * sizeof(tl_word_t);
+		size -= n * sizeof(tl_word_t);
+	}
+
+	while (size--) {
+		cs += *b++;
+	}
+
+	return cs;
+}
+
+/*******************************************************************************
+ * Update the checksum of a transfer list after a range of bytes with the byte
+ * sum old_sum has been replaced by bytes with the byte sum new_sum, without
+ * going over the whole list. The checksum must have been valid before.
+ ******************************************************************************/
+static void update_checksum_delta(struct transfer_list_header *tl,
+				  uint8_t old_sum, uint8_t new_sum)
+{
+	tl->checksum -= (uint8_t)(new_sum - old_sum);
+	assert(transfer_list_verify_checksum(tl));
+}
+
 void transfer_list_dump(struct transfer_list_header *tl)
 {
 	struct transfer_list_entry *te = NULL;
@@ -61,6 +149,8 @@ struct transfer_list_header *transfer_list_init(void *addr, size_t max_size)
 		return NULL;
 	}
 
+	index_invalidate(tl);
+
 	memset(tl, 0, max_size);
 	tl->signature = TRANSFER_LIST_SIGNATURE;
 	tl->version = TRANSFER_LIST_VERSION;
@@ -85,11 +175,12 @@ struct transfer_list_header *transfer_list_relocate(
 {
 	uintptr_t new_addr, align_mask, align_off;
 	struct transfer_list_header *new_tl;
-	uint32_t new_max_size;
+	uint32_t new_max_size, old_max_size;
 
 	if (!tl || !addr || max_size == 0) {
 		return NULL;
 	}
+	old_max_size = tl->max_size;
 
 	align_mask = (1 << tl->alignment) - 1;
 	align_off = (uintptr_t)tl & align_mask;
@@ -108,9 +199,14 @@ struct transfer_list_header *transfer_list_relocate(
 
 	new_tl = (struct transfer_list_header *)new_addr;
 	memmove(new_tl, tl, tl->size);
-	new_tl->max_size = new_max_size;
+	index_invalidate(tl);
+	index_invalidate(new_tl);
 
-	transfer_list_update_checksum(new_tl);
+	// only the max size has changed
+	new_tl->max_size = new_max_size;
+	update_checksum_delta(new_tl,
+			      sum_bytes(&old_max_size, sizeof(old_max_size)),
+			      sum_bytes(&new_max_size, sizeof(new_max_size)));
 
 	return new_tl;
 }
@@ -222,19 +318,11 @@ struct transfer_list_entry *transfer_list_next(struct transfer_list_header *tl,
  ******************************************************************************/
 static uint8_t calc_byte_sum(const struct transfer_list_header *tl)
 {
-	uint8_t *b = (uint8_t *)tl;
-	uint8_t cs = 0;
-	size_t n = 0;
-
 	if (!tl) {
 		return 0;
 	}
 
-	for (n = 0; n < tl->size; n++) {
-		cs += b[n];
-	}
-
-	return cs;
+	return sum_bytes(tl, tl->size);
 }
 
 /*******************************************************************************
@@ -278,6 +366,7 @@ bool transfer_list_set_data_size(struct transfer_list_header *tl,
 	size_t gap = 0;
 	size_t mov_dis = 0;
 	size_t sz = 0;
+	uint8_t old_sum;
 
 	if (!tl || !te) {
 		return false;
@@ -297,6 +386,11 @@ bool transfer_list_set_data_size(struct transfer_list_header *tl,
 		return false;
 	}
 
+	// only the TL header and the bytes up to the end of the TE change,
+	// the bytes after the TE are moved as a block
+	old_sum = sum_bytes(tl, tl->hdr_size) +
+		  sum_bytes(te, old_ev - (uintptr_t)te);
+
 	if (new_ev > old_ev) {
 		// move distance should be roundup
 		// to meet the requirement of TE data max alignment
@@ -310,6 +404,7 @@ bool transfer_list_set_data_size(struct transfer_list_header *tl,
 		ru_new_ev = old_ev + mov_dis;
 		memmove((void *)ru_new_ev, (void *)old_ev, tl_old_ev - old_ev);
 		tl->size += mov_dis;
+		index_invalidate(tl);
 		gap = ru_new_ev - new_ev;
 	} else {
 		gap = old_ev - new_ev;
@@ -326,7 +421,8 @@ bool transfer_list_set_data_size(struct transfer_list_header *tl,
 
 	te->data_size = new_data_size;
 
-	transfer_list_update_checksum(tl);
+	update_checksum_delta(tl, old_sum, sum_bytes(tl, tl->hdr_size) +
+			      sum_bytes(te, old_ev + mov_dis - (uintptr_t)te));
 	return true;
 }
 
@@ -337,12 +433,16 @@ bool transfer_list_set_data_size(struct transfer_list_header *tl,
 bool transfer_list_rem(struct transfer_list_header *tl,
 			struct transfer_list_entry *te)
 {
+	uint8_t old_sum;
+
 	if (!tl || !te || (uintptr_t)te > (uintptr_t)tl + tl->size) {
 		return false;
 	}
+	old_sum = sum_bytes(te, sizeof(*te));
 	te->tag_id = TL_TAG_EMPTY;
 	te->reserved0 = 0;
-	transfer_list_update_checksum(tl);
+	index_invalidate(tl);
+	update_checksum_delta(tl, old_sum, sum_bytes(te, sizeof(*te)));
 	return true;
 }
 
@@ -360,6 +460,7 @@ struct transfer_list_entry *transfer_list_add(struct transfer_list_header *tl,
 	struct transfer_list_entry *te = NULL;
 	uint8_t *te_data = NULL;
 	size_t sz = 0;
+	uint8_t old_sum;
 
 	if (!tl) {
 		return NULL;
@@ -377,6 +478,8 @@ struct transfer_list_entry *transfer_list_add(struct transfer_list_header *tl,
 		return NULL;
 	}
 
+	old_sum = sum_bytes(tl, tl->hdr_size);
+
 	te = (struct transfer_list_entry *)tl_ev;
 	te->tag_id = tag_id;
 	te->reserved0 = 0;
@@ -393,7 +496,9 @@ struct transfer_list_entry *transfer_list_add(struct transfer_list_header *tl,
 		memmove(te_data, data, data_size);
 	}
 
-	transfer_list_update_checksum(tl);
+	// the new TE and its padding were outside of the TL before
+	update_checksum_delta(tl, old_sum, sum_bytes(tl, tl->hdr_size) +
+			      sum_bytes(te, ev - tl_ev));
 
 	return te;
 }
@@ -437,8 +542,10 @@ struct transfer_list_entry *transfer_list_add_with_align(
 	te = transfer_list_add(tl, tag_id, data_size, data);
 
 	if (alignment > tl->alignment) {
+		uint8_t old_alignment = tl->alignment;
+
 		tl->alignment = alignment;
-		transfer_list_update_checksum(tl);
+		update_checksum_delta(tl, old_alignment, alignment);
 	}
 
 	return te;
@@ -454,10 +561,41 @@ struct transfer_list_entry *transfer_list_find(struct transfer_list_header *tl,
 {
 	struct transfer_list_entry *te = NULL;
 
+#if TRANSFER_LIST_INDEX_SIZE
+	unsigned int i;
+
+	for (i = 0U; i < TRANSFER_LIST_INDEX_SIZE; i++) {
+		if (tl_index[i].tl != tl || tl_index[i].tag_id != tag_id) {
+			continue;
+		}
+
+		te = (struct transfer_list_entry *)((uintptr_t)tl +
+						    tl_index[i].offset);
+		// recheck the entry in case it was modified by the caller
+		if (tl_index[i].offset + sizeof(*te) <= tl->size &&
+		    te->tag_id == tag_id && te->reserved0 == 0) {
+			return te;
+		}
+
+		tl_index[i].tl = NULL;
+	}
+	te = NULL;
+#endif
+
 	do {
 		te = transfer_list_next(tl, te);
 	} while (te && (te->tag_id != tag_id || te->reserved0 != 0));
 
+#if TRANSFER_LIST_INDEX_SIZE
+	if (te) {
+		i = tl_index_next;
+		tl_index_next = (tl_index_next + 1U) % TRANSFER_LIST_INDEX_SIZE;
+		tl_index[i].tl = tl;
+		tl_index[i].offset = (uint32_t)((uintptr_t)te - (uintptr_t)tl);
+		tl_index[i].tag_id = tag_id;
+	}
+#endif
+
 	return te;
 }
 
@@ -10,6 +10,8 @@ ifeq (${ARCH},aarch32)
 $(eval $(call add_define,TRANSFER_LIST_AARCH32))
 endif
 
+$(eval $(call add_define,TRANSFER_LIST_INDEX_SIZE))
+
 TRANSFER_LIST_SOURCES	+=	$(addprefix lib/transfer_list/,	\
 				transfer_list.c)
 
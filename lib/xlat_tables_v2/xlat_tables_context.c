@@ -10,8 +10,11 @@
 #include <platform_def.h>
 
 #include <common/debug.h>
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
+#include <plat/common/platform.h>
 
 #include "xlat_tables_private.h"
 
@@ -28,6 +31,16 @@ uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
 REGISTER_XLAT_CONTEXT(tf, MAX_MMAP_REGIONS, MAX_XLAT_TABLES,
 		      PLAT_VIRT_ADDR_SPACE_SIZE, PLAT_PHY_ADDR_SPACE_SIZE);
 
+#if PLAT_XLAT_CPU_WINDOWS
+CASSERT(IS_PAGE_ALIGNED(PLAT_XLAT_CPU_WINDOW_BASE) &&
+	IS_PAGE_ALIGNED(PLAT_XLAT_CPU_WINDOW_SIZE) &&
+	(PLAT_XLAT_CPU_WINDOW_SIZE != 0U),
+	assert_plat_xlat_cpu_window_alignment);
+
+/* Number of bytes of the window of each CPU currently in use. */
+static size_t cpu_window_used[PLATFORM_CORE_COUNT];
+#endif /* PLAT_XLAT_CPU_WINDOWS */
+
 void mmap_add_region(unsigned long long base_pa, uintptr_t base_va, size_t size,
 		     unsigned int attr)
 {
@@ -107,6 +120,13 @@ void __init init_xlat_tables(void)
 		tf_xlat_ctx.xlat_regime = EL3_REGIME;
 	}
 
+#if PLAT_XLAT_CPU_WINDOWS
+	mmap_region_t windows = MAP_SCRATCH_WINDOW(PLAT_XLAT_CPU_WINDOW_BASE,
+			PLAT_XLAT_CPU_WINDOW_SIZE * PLATFORM_CORE_COUNT);
+
+	mmap_add_region_ctx(&tf_xlat_ctx, &windows);
+#endif
+
 	init_xlat_tables_ctx(&tf_xlat_ctx);
 }
 
@@ -120,6 +140,87 @@ int xlat_change_mem_attributes(uintptr_t base_va, size_t size, uint32_t attr)
 	return xlat_change_mem_attributes_ctx(&tf_xlat_ctx, base_va, size, attr);
 }
 
+int xlat_map_scratch_window(uintptr_t window_va, unsigned long long base_pa,
+			    size_t size, uint32_t attr)
+{
+	return xlat_map_scratch_window_ctx(&tf_xlat_ctx, window_va, base_pa,
+					   size, attr);
+}
+
+int xlat_unmap_scratch_window(uintptr_t window_va, size_t size)
+{
+	return xlat_unmap_scratch_window_ctx(&tf_xlat_ctx, window_va, size);
+}
+
+#if PLAT_XLAT_CPU_WINDOWS
+/*
+ * Each CPU owns a slice of the scratch window region and allocates mappings
+ * from it like a stack. As no other CPU changes the slice, no lock is needed.
+ * The slices are in the translation tables shared by all CPUs though, so TLB
+ * maintenance is still broadcast.
+ */
+static uintptr_t cpu_window_slice_va(unsigned int core_pos)
+{
+	assert(core_pos < PLATFORM_CORE_COUNT);
+
+	return PLAT_XLAT_CPU_WINDOW_BASE +
+	       ((uintptr_t)core_pos * PLAT_XLAT_CPU_WINDOW_SIZE);
+}
+
+void *xlat_cpu_window_map(unsigned long long pa, size_t size, uint32_t attr)
+{
+	unsigned int core_pos = plat_my_core_pos();
+	unsigned long long base_pa = pa & ~(unsigned long long)PAGE_SIZE_MASK;
+	uintptr_t slice_va = cpu_window_slice_va(core_pos);
+	size_t map_size;
+	uintptr_t va;
+
+	assert(size != 0U);
+
+	/* The mapping must fit in the unused part of the slice of this CPU */
+	map_size = round_up((size_t)(pa - base_pa) + size, PAGE_SIZE);
+	if (map_size > (PLAT_XLAT_CPU_WINDOW_SIZE - cpu_window_used[core_pos])) {
+		return NULL;
+	}
+
+	va = slice_va + cpu_window_used[core_pos];
+
+	if (xlat_map_scratch_window_ctx(&tf_xlat_ctx, va, base_pa,
+					map_size, attr) != 0) {
+		return NULL;
+	}
+
+	cpu_window_used[core_pos] += map_size;
+
+	return (void *)(va + (uintptr_t)(pa - base_pa));
+}
+
+void xlat_cpu_window_unmap(const void *va, size_t size)
+{
+	unsigned int core_pos = plat_my_core_pos();
+	uintptr_t slice_va = cpu_window_slice_va(core_pos);
+	uintptr_t base_va = (uintptr_t)va & ~PAGE_SIZE_MASK;
+	size_t map_size = round_up(((uintptr_t)va - base_va) + size, PAGE_SIZE);
+
+	/*
+	 * Mappings must be released in the reverse order of creation, so the
+	 * range must be the top of the used part of the slice of this CPU.
+	 */
+	if ((map_size > cpu_window_used[core_pos]) ||
+	    (base_va != (slice_va + cpu_window_used[core_pos] - map_size))) {
+		ERROR("%s: 0x%lx (size 0x%zx) is not the last CPU window.\n",
+		      __func__, (uintptr_t)va, size);
+		panic();
+	}
+
+	/* The range is within the slice, so the unmap can't fail. */
+	xlat_scratch_window_invalidate(&tf_xlat_ctx, base_va,
+				       map_size / PAGE_SIZE);
+
+	cpu_window_used[core_pos] -= map_size;
+}
+#endif /* PLAT_XLAT_CPU_WINDOWS */
+
 #if PLAT_RO_XLAT_TABLES
 /* Change the memory attributes of the descriptors which resolve the address
  * range that belongs to the translation tables themselves, which are by default
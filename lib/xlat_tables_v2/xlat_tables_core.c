@@ -605,9 +605,14 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 
 		if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
-			table_base[table_idx] =
-				xlat_desc(ctx, (uint32_t)mm->attr, table_idx_pa,
-					  level);
+			/* Scratch windows stay unmapped until they are used */
+			if ((mm->attr & MT_SCRATCH) != 0U) {
+				table_base[table_idx] = INVALID_DESC;
+			} else {
+				table_base[table_idx] =
+					xlat_desc(ctx, (uint32_t)mm->attr,
+						  table_idx_pa, level);
+			}
 
 		} else if (action == ACTION_CREATE_NEW_TABLE) {
 			uintptr_t end_va;
@@ -706,6 +711,16 @@ static int mmap_add_region_check(const xlat_ctx_t *ctx, const mmap_region_t *mm)
 	if (end_pa > ctx->pa_max_address)
 		return -ERANGE;
 
+	/* Scratch windows must be resolved by last level tables */
+	if (((mm->attr & MT_SCRATCH) != 0U) && (granularity != PAGE_SIZE))
+		return -EINVAL;
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+	/* Scratch windows are only recorded for static regions */
+	if (((mm->attr & MT_SCRATCH) != 0U) && ((mm->attr & MT_DYNAMIC) != 0U))
+		return -EINVAL;
+#endif /* PLAT_XLAT_TABLES_DYNAMIC */
+
 	/* Check that there is space in the ctx->mmap array */
 	if (ctx->mmap[ctx->mmap_num - 1].size != 0U)
 		return -ENOMEM;
@@ -717,6 +732,10 @@ static int mmap_add_region_check(const xlat_ctx_t *ctx, const mmap_region_t *mm)
 		uintptr_t mm_cursor_end_va = mm_cursor->base_va
 							+ mm_cursor->size - 1U;
 
+		/* A context has at most one scratch window region */
+		if ((mm->attr & mm_cursor->attr & MT_SCRATCH) != 0U)
+			return -EPERM;
+
 		/*
 		 * Check if one of the regions is completely inside the other
 		 * one.
@@ -735,6 +754,10 @@ static int mmap_add_region_check(const xlat_ctx_t *ctx, const mmap_region_t *mm)
 		 */
 		if (fully_overlapped_va) {
 
+			/* Scratch windows can't share VAs with other regions */
+			if (((mm->attr | mm_cursor->attr) & MT_SCRATCH) != 0U)
+				return -EPERM;
+
 #if PLAT_XLAT_TABLES_DYNAMIC
 			if (((mm->attr & MT_DYNAMIC) != 0U) ||
 			    ((mm_cursor->attr & MT_DYNAMIC) != 0U))
@@ -763,6 +786,10 @@ static int mmap_add_region_check(const xlat_ctx_t *ctx, const mmap_region_t *mm)
 			bool separated_va = (end_va < mm_cursor->base_va) ||
 				(base_va > mm_cursor_end_va);
 
+			/* The PA of a scratch window is never mapped */
+			if (((mm->attr | mm_cursor->attr) & MT_SCRATCH) != 0U)
+				separated_pa = true;
+
 			if (!separated_va || !separated_pa)
 				return -EPERM;
 		}
@@ -771,9 +798,59 @@ static int mmap_add_region_check(const xlat_ctx_t *ctx, const mmap_region_t *mm)
 	return 0;
 }
 
+/*
+ * The used entries of the mmap array are kept sorted (see
+ * mmap_add_region_ctx()) and followed by empty entries, so it can be indexed
+ * with a binary search instead of walking it.
+ *
+ * Returns the first entry that must be placed after a region ending at
+ * 'end_va' with the given 'size'. This is the insertion point of such a
+ * region, or the region itself if it is already in the array.
+ */
+static mmap_region_t *mmap_find_pos(const xlat_ctx_t *ctx, uintptr_t end_va,
+				    size_t size)
+{
+	unsigned int lo = 0U, hi = ctx->mmap_num;
+
+	/* The last entry of the array is always empty. */
+	while (lo < hi) {
+		unsigned int mid = lo + ((hi - lo) / 2U);
+		const mmap_region_t *mm = &ctx->mmap[mid];
+		uintptr_t mm_end_va = mm->base_va + mm->size - 1U;
+
+		if ((mm->size != 0U) &&
+		    ((mm_end_va < end_va) ||
+		     ((mm_end_va == end_va) && (mm->size < size)))) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return &ctx->mmap[lo];
+}
+
+/* Returns the first empty entry of the mmap array. */
+static mmap_region_t *mmap_find_last(const xlat_ctx_t *ctx)
+{
+	unsigned int lo = 0U, hi = ctx->mmap_num;
+
+	while (lo < hi) {
+		unsigned int mid = lo + ((hi - lo) / 2U);
+
+		if (ctx->mmap[mid].size != 0U) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return &ctx->mmap[lo];
+}
+
 void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 {
-	mmap_region_t *mm_cursor = ctx->mmap, *mm_destination;
+	mmap_region_t *mm_cursor, *mm_destination;
 	const mmap_region_t *mm_end = ctx->mmap + ctx->mmap_num;
 	const mmap_region_t *mm_last;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
@@ -817,24 +894,12 @@ void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 	 *
 	 * Overlapping is only allowed for static regions.
 	 */
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) < end_va)
-	       && (mm_cursor->size != 0U)) {
-		++mm_cursor;
-	}
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) == end_va) &&
-	       (mm_cursor->size != 0U) && (mm_cursor->size < mm->size)) {
-		++mm_cursor;
-	}
+	mm_cursor = mmap_find_pos(ctx, end_va, mm->size);
 
 	/*
 	 * Find the last entry marker in the mmap
 	 */
-	mm_last = ctx->mmap;
-	while ((mm_last->size != 0U) && (mm_last < mm_end)) {
-		++mm_last;
-	}
+	mm_last = mmap_find_last(ctx);
 
 	/*
 	 * Check if we have enough space in the memory mapping table.
@@ -951,8 +1016,8 @@ void mmap_add_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 
 int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 {
-	mmap_region_t *mm_cursor = ctx->mmap;
-	const mmap_region_t *mm_last = mm_cursor + ctx->mmap_num;
+	mmap_region_t *mm_cursor;
+	const mmap_region_t *mm_last = ctx->mmap + ctx->mmap_num;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
 	uintptr_t end_va = mm->base_va + mm->size - 1U;
 	int ret;
@@ -972,16 +1037,7 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 	 * Find the adequate entry in the mmap array in the same way done for
 	 * static regions in mmap_add_region_ctx().
 	 */
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) < end_va)
-	       && (mm_cursor->size != 0U)) {
-		++mm_cursor;
-	}
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) == end_va) &&
-	       (mm_cursor->size != 0U) && (mm_cursor->size < mm->size)) {
-		++mm_cursor;
-	}
+	mm_cursor = mmap_find_pos(ctx, end_va, mm->size);
 
 	/* Make room for new region by moving other regions up by one place */
 	(void)memmove(mm_cursor + 1U, mm_cursor,
@@ -1086,22 +1142,22 @@ int mmap_add_dynamic_region_alloc_va_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size)
 {
-	mmap_region_t *mm = ctx->mmap;
-	const mmap_region_t *mm_last = mm + ctx->mmap_num;
+	mmap_region_t *mm;
+	const mmap_region_t *mm_last = ctx->mmap + ctx->mmap_num;
 	int update_max_va_needed = 0;
 	int update_max_pa_needed = 0;
 
 	/* Check sanity of mmap array. */
-	assert(mm[ctx->mmap_num].size == 0U);
+	assert(ctx->mmap[ctx->mmap_num].size == 0U);
 
-	while (mm->size != 0U) {
-		if ((mm->base_va == base_va) && (mm->size == size))
-			break;
-		++mm;
-	}
+	if (size == 0U)
+		return -EINVAL;
+
+	/* Regions can't be added twice, so there is at most one match. */
+	mm = mmap_find_pos(ctx, base_va + size - 1U, size);
 
 	/* Check that the region was found */
-	if (mm->size == 0U)
+	if ((mm->size == 0U) || (mm->base_va != base_va) || (mm->size != size))
 		return -EINVAL;
 
 	/* If the region is static it can't be removed */
@@ -1129,14 +1185,16 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 	/* Remove this region by moving the rest down by one place. */
 	(void)memmove(mm, mm + 1U, (uintptr_t)mm_last - (uintptr_t)mm);
 
-	/* Check if we need to update the max VAs and PAs */
+	/*
+	 * Check if we need to update the max VAs and PAs. The array is sorted
+	 * by end VA, so the max VA is the end of the last region.
+	 */
 	if (update_max_va_needed == 1) {
 		ctx->max_va = 0U;
-		mm = ctx->mmap;
-		while (mm->size != 0U) {
-			if ((mm->base_va + mm->size - 1U) > ctx->max_va)
-				ctx->max_va = mm->base_va + mm->size - 1U;
-			++mm;
+		mm = mmap_find_last(ctx);
+		if (mm != ctx->mmap) {
+			--mm;
+			ctx->max_va = mm->base_va + mm->size - 1U;
 		}
 	}
 
@@ -1180,6 +1238,8 @@ void xlat_setup_dynamic_ctx(xlat_ctx_t *ctx, unsigned long long pa_max,
 
 	ctx->max_pa = 0;
 	ctx->max_va = 0;
+	ctx->scratch_base_va = 0;
+	ctx->scratch_size = 0;
 	ctx->initialized = 0;
 }
 
@@ -1231,6 +1291,12 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 			panic();
 		}
 
+		if ((mm->attr & MT_SCRATCH) != 0U) {
+			assert(ctx->scratch_size == 0U);
+			ctx->scratch_base_va = mm->base_va;
+			ctx->scratch_size = mm->size;
+		}
+
 		mm++;
 	}
 
@@ -83,6 +83,13 @@ void xlat_tables_print(xlat_ctx_t *ctx);
 uint64_t xlat_desc(const xlat_ctx_t *ctx, uint32_t attr,
 		   unsigned long long addr_pa, unsigned int level);
 
+/*
+ * Invalidate the page descriptors of a scratch window whose bounds have
+ * already been checked by the caller.
+ */
+void xlat_scratch_window_invalidate(const xlat_ctx_t *ctx,
+				    uintptr_t window_va, size_t pages_count);
+
 /*
  * Architecture-specific initialization code.
  */
@@ -590,3 +590,187 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 
 	return 0;
 }
+
+/*
+ * Returns a pointer to the last level translation table entry that resolves
+ * the given virtual address, whether it is valid or not. On error, or if the
+ * address isn't resolved by a last level table, return NULL.
+ */
+static uint64_t *find_xlat_page_entry(const xlat_ctx_t *ctx,
+				      uintptr_t virtual_addr)
+{
+	unsigned long long virt_addr_space_size =
+		(unsigned long long)ctx->va_max_address + 1ULL;
+	unsigned int start_level = GET_XLAT_TABLE_LEVEL_BASE(virt_addr_space_size);
+	uint64_t *table = ctx->base_table;
+	unsigned int entries = ctx->base_table_entries;
+
+	for (unsigned int level = start_level;
+	     level < XLAT_TABLE_LEVEL_MAX;
+	     ++level) {
+		uint64_t idx = XLAT_TABLE_IDX(virtual_addr, level);
+		uint64_t desc;
+
+		if (idx >= entries) {
+			return NULL;
+		}
+
+		desc = table[idx];
+		if ((desc & DESC_MASK) != TABLE_DESC) {
+			return NULL;
+		}
+
+		table = (uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK);
+		entries = XLAT_TABLE_ENTRIES;
+	}
+
+	return &table[XLAT_TABLE_IDX(virtual_addr, XLAT_TABLE_LEVEL_MAX)];
+}
+
+/*
+ * Validate the arguments of the scratch window functions and return the
+ * number of pages of the window, or 0 on error. The window must be fully inside
+ * the region declared with MAP_SCRATCH_WINDOW(), so that live mappings of the
+ * context can't be changed through these functions. That region is recorded
+ * at initialization, so the mmap array, which dynamic regions may be shifting
+ * on other CPUs, isn't looked at.
+ */
+static size_t xlat_scratch_window_pages(const xlat_ctx_t *ctx,
+					uintptr_t window_va, size_t size)
+{
+	uintptr_t end_va = window_va + size - 1U;
+
+	assert(ctx != NULL);
+	assert(ctx->initialized);
+
+	if (!IS_PAGE_ALIGNED(window_va) || (size == 0U) ||
+	    ((size % PAGE_SIZE) != 0U) || (end_va < window_va)) {
+		WARN("%s: Invalid window 0x%lx (size 0x%zx).\n",
+		     __func__, window_va, size);
+		return 0U;
+	}
+
+	if ((ctx->scratch_size != 0U) && (window_va >= ctx->scratch_base_va) &&
+	    (end_va <= (ctx->scratch_base_va + ctx->scratch_size - 1U))) {
+		return size / PAGE_SIZE;
+	}
+
+	WARN("%s: 0x%lx (size 0x%zx) is not a scratch window.\n",
+	     __func__, window_va, size);
+	return 0U;
+}
+
+/*
+ * The windows live in translation tables shared by all PEs, which can walk
+ * and cache their entries speculatively. So TLB maintenance is always
+ * broadcast to the Inner Shareable domain to complete break-before-make, even
+ * for windows that are only accessed by one PE.
+ */
+int xlat_map_scratch_window_ctx(const xlat_ctx_t *ctx, uintptr_t window_va,
+				unsigned long long base_pa, size_t size,
+				uint32_t attr)
+{
+	size_t pages_count = xlat_scratch_window_pages(ctx, window_va, size);
+	uintptr_t va = window_va;
+	unsigned long long pa = base_pa;
+	bool tlbi_needed = false;
+
+	if (pages_count == 0U) {
+		return -EINVAL;
+	}
+
+	if ((base_pa & PAGE_SIZE_MASK) != 0ULL) {
+		WARN("%s: PA 0x%llx is not page aligned.\n", __func__, base_pa);
+		return -EINVAL;
+	}
+
+	if (((base_pa + size - 1U) < base_pa) ||
+	    ((base_pa + size - 1U) > ctx->pa_max_address)) {
+		WARN("%s: PA 0x%llx (size 0x%zx) is out of range.\n",
+		     __func__, base_pa, size);
+		return -ERANGE;
+	}
+
+	if (((attr & MT_EXECUTE_NEVER) == 0U) && ((attr & MT_RW) != 0U)) {
+		WARN("%s: Mapping memory as read-write and executable not allowed.\n",
+		     __func__);
+		return -EINVAL;
+	}
+
+	/*
+	 * Break-before-make: invalidate any live entry of the window before
+	 * writing the new descriptors. Scratch windows are always backed by
+	 * last level tables.
+	 */
+	for (size_t i = 0U; i < pages_count; ++i) {
+		uint64_t *entry = find_xlat_page_entry(ctx, va);
+
+		assert(entry != NULL);
+		if ((*entry & DESC_MASK) != INVALID_DESC) {
+			*entry = INVALID_DESC;
+#if !HW_ASSISTED_COHERENCY
+			dccvac((uintptr_t)entry);
+#endif
+			xlat_arch_tlbi_va(va, ctx->xlat_regime);
+			tlbi_needed = true;
+		}
+		va += PAGE_SIZE;
+	}
+
+	if (tlbi_needed) {
+		xlat_arch_tlbi_va_sync();
+	}
+
+	va = window_va;
+	for (size_t i = 0U; i < pages_count; ++i) {
+		uint64_t *entry = find_xlat_page_entry(ctx, va);
+
+		*entry = xlat_desc(ctx, attr, pa, XLAT_TABLE_LEVEL_MAX);
+#if !HW_ASSISTED_COHERENCY
+		dccvac((uintptr_t)entry);
+#endif
+		va += PAGE_SIZE;
+		pa += PAGE_SIZE;
+	}
+
+	/* Ensure that the new descriptors are seen before the window is used. */
+	dsbishst();
+	isb();
+
+	return 0;
+}
+
+void xlat_scratch_window_invalidate(const xlat_ctx_t *ctx,
+				    uintptr_t window_va, size_t pages_count)
+{
+	uintptr_t va = window_va;
+
+	for (size_t i = 0U; i < pages_count; ++i) {
+		uint64_t *entry = find_xlat_page_entry(ctx, va);
+
+		assert(entry != NULL);
+		*entry = INVALID_DESC;
+#if !HW_ASSISTED_COHERENCY
+		dccvac((uintptr_t)entry);
+#endif
+		xlat_arch_tlbi_va(va, ctx->xlat_regime);
+		va += PAGE_SIZE;
+	}
+
+	/* Ensure completion of the invalidation. */
+	xlat_arch_tlbi_va_sync();
+}
+
+int xlat_unmap_scratch_window_ctx(const xlat_ctx_t *ctx, uintptr_t window_va,
+				  size_t size)
+{
+	size_t pages_count = xlat_scratch_window_pages(ctx, window_va, size);
+
+	if (pages_count == 0U) {
+		return -EINVAL;
+	}
+
+	xlat_scratch_window_invalidate(ctx, window_va, pages_count);
+
+	return 0;
+}
@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <common/debug.h>
@@ -102,6 +103,109 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	return ret;
 }
 
+/*
+ * State of the streaming decompression, fed piecewise by gunzip_stream_update()
+ * between gunzip_stream_init() and gunzip_stream_final().
+ */
+static z_stream gunzip_strm;
+static bool gunzip_strm_done;
+
+/*
+ * gunzip_stream_init - start streaming decompression of gzip data
+ * @out_buf: destination of decompressed output
+ * @out_len: length of out_buf
+ * @work_buf: workspace
+ * @work_len: length of workspace
+ */
+int gunzip_stream_init(uintptr_t out_buf, size_t out_len, uintptr_t work_buf,
+		       size_t work_len)
+{
+	int zret;
+
+	zalloc_start = work_buf;
+	zalloc_end = work_buf + work_len;
+	zalloc_current = zalloc_start;
+
+	zeromem(&gunzip_strm, sizeof(gunzip_strm));
+	gunzip_strm.next_out = (typeof(gunzip_strm.next_out))out_buf;
+	gunzip_strm.avail_out = out_len;
+	gunzip_strm.zalloc = zcalloc;
+	gunzip_strm.zfree = zfree;
+	gunzip_strm.opaque = (voidpf)0;
+	gunzip_strm_done = false;
+
+	zret = inflateInit(&gunzip_strm);
+	if (zret != Z_OK) {
+		ERROR("zlib: inflate init failed (ret = %d)\n", zret);
+		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+	}
+
+	return 0;
+}
+
+/*
+ * gunzip_stream_update - decompress the next chunk of gzip data
+ * @in_buf: chunk of compressed input
+ * @in_len: length of in_buf
+ *
+ * Input following the end of the gzip stream is ignored.
+ */
+int gunzip_stream_update(uintptr_t in_buf, size_t in_len)
+{
+	int zret;
+
+	if (gunzip_strm_done || (in_len == 0U))
+		return 0;
+
+	gunzip_strm.next_in = (typeof(gunzip_strm.next_in))in_buf;
+	gunzip_strm.avail_in = in_len;
+
+	zret = inflate(&gunzip_strm, Z_NO_FLUSH);
+	if (zret == Z_STREAM_END) {
+		gunzip_strm_done = true;
+		return 0;
+	}
+
+	/* The whole chunk must be consumed unless the output is full */
+	if ((zret != Z_OK) || (gunzip_strm.avail_in != 0U)) {
+		if (gunzip_strm.msg)
+			ERROR("%s\n", gunzip_strm.msg);
+		ERROR("zlib: inflate failed (ret = %d)\n", zret);
+		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+	}
+
+	return 0;
+}
+
+/*
+ * gunzip_stream_final - conclude streaming decompression
+ * @out_buf: upon exit, the end of output.
+ *
+ * Returns an error if the end of the gzip stream has not been reached.
+ */
+int gunzip_stream_final(uintptr_t *out_buf)
+{
+	int ret = gunzip_strm_done ? 0 : -EIO;
+
+	if (ret != 0)
+		ERROR("zlib: truncated input\n");
+
+	VERBOSE("zlib: %lu byte input\n", gunzip_strm.total_in);
+	VERBOSE("zlib: %lu byte output\n", gunzip_strm.total_out);
+
+	*out_buf = (uintptr_t)gunzip_strm.next_out;
+
+	inflateEnd(&gunzip_strm);
+
+	return ret;
+}
+
+const stream_decompressor_t gunzip_stream_decompressor = {
+	.init = gunzip_stream_init,
+	.update = gunzip_stream_update,
+	.final = gunzip_stream_final,
+};
+
 /* Wrapper function to calculate CRC
  * @crc: previous accumulated CRC
  * @buf: buffer base address
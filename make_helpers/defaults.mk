@@ -79,6 +79,9 @@ DISABLE_BIN_GENERATION		:= 0
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Flag to enable the EL3 runtime profiler
+ENABLE_EL3_PROFILER		:= 0
+
 # Enable the Maximum Power Mitigation Mechanism on supporting cores.
 ENABLE_MPMM			:= 0
 
@@ -121,6 +124,10 @@ ERROR_DEPRECATED		:= 0
 # Fault injection support
 FAULT_INJECTION_SUPPORT		:= 0
 
+# Number of hash table slots used to index the properties and nodes of a
+# device tree while fconf populates from it. 0 disables the index.
+FDT_WRAPPERS_INDEX_SIZE		:= 0
+
 # Flag to enable architectural features detection mechanism
 FEATURE_DETECTION		:= 0
 
@@ -150,6 +157,10 @@ HANDLE_EA_EL3_FIRST_NS		:= 0
 # Enable Handoff protocol using transfer lists
 TRANSFER_LIST			:= 0
 
+# Number of transfer list entries whose location is cached by
+# transfer_list_find(). 0 disables the cache.
+TRANSFER_LIST_INDEX_SIZE	:= 0
+
 # Enables support for the gcc compiler option "-mharden-sls=all".
 # By default, disables all SLS hardening.
 HARDEN_SLS			:= 0
@@ -165,6 +176,10 @@ HW_ASSISTED_COHERENCY		:= 0
 # Flag to enable trapping of implementation defined sytem registers
 IMPDEF_SYSREG_TRAP		:= 0
 
+# Flag to let BL2 decompress gzip images marked with
+# IMAGE_ATTRIB_DECOMPRESS_STREAM while they are read from storage
+IMAGE_DECOMPRESS_STREAM		:= 0
+
 # Set the default algorithm for the generation of Trusted Board Boot keys
 KEY_ALG				:= rsa
 
@@ -189,6 +204,9 @@ PL011_GENERIC_UART		:= 0
 # The platform Makefile is free to override this value.
 PROGRAMMABLE_RESET_ADDRESS	:= 0
 
+# Flag to give the PSCI per-CPU and per-power-domain data their own cache lines
+PSCI_CACHE_LINE_ALIGN		:= 0
+
 # Flag used to choose the power state format: Extended State-ID or Original
 PSCI_EXTENDED_STATE_ID		:= 0
 
@@ -324,9 +342,22 @@ ERRATA_SPECULATIVE_AT		:= 0
 # Trap RAS error record access from Non secure
 RAS_TRAP_NS_ERR_REC_ACCESS	:= 0
 
+# Count errors per RAS error record group and report them through a SiP SMC
+RAS_ERR_STATS			:= 0
+
+# Corrected errors per second passed on to each RAS error record group handler
+# (0 for no limit). Requires RAS_ERR_STATS.
+RAS_CE_RATE_LIMIT		:= 0
+
 # Build option to create cot descriptors using fconf
 COT_DESC_IN_DTB			:= 0
 
+# Build option to convert the cot descriptors in DT into C tables at build time
+COT_DESC_PRECOMPILED		:= 0
+
+# Device tree source describing the cot, used when COT_DESC_PRECOMPILED=1
+COT_DESC_DTS			:= fdts/cot_descriptors.dtsi
+
 # Build option to provide OpenSSL directory path
 OPENSSL_DIR			:= /usr
 
@@ -371,7 +371,9 @@ ifneq (${TRUSTED_BOARD_BOOT},0)
     ifeq (${COT},tbbr)
             BL1_SOURCES	+=	drivers/auth/tbbr/tbbr_cot_common.c		\
 				drivers/auth/tbbr/tbbr_cot_bl1.c
-        ifneq (${COT_DESC_IN_DTB},0)
+        ifeq (${COT_DESC_PRECOMPILED},1)
+            BL2_SOURCES	+=	${COT_DESC_C}
+        else ifneq (${COT_DESC_IN_DTB},0)
             BL2_SOURCES	+=	lib/fconf/fconf_cot_getter.c
         else
             BL2_SOURCES	+=	drivers/auth/tbbr/tbbr_cot_common.c
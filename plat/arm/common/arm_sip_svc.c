@@ -10,6 +10,7 @@
 #include <common/runtime_svc.h>
 #include <drivers/arm/ethosn.h>
 #include <lib/debugfs.h>
+#include <lib/extensions/ras.h>
 #include <lib/pmf/pmf.h>
 #include <plat/arm/common/arm_sip_svc.h>
 #include <plat/arm/common/plat_arm.h>
@@ -90,6 +91,15 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 
 #endif /* ETHOSN_NPU_DRIVER */
 
+#if RAS_ERR_STATS
+
+	if (is_ras_fid(smc_fid)) {
+		return ras_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+				       handle, flags);
+	}
+
+#endif /* RAS_ERR_STATS */
+
 	switch (smc_fid) {
 	case ARM_SIP_SVC_EXE_STATE_SWITCH: {
 		/* Execution state can be switched only if EL3 is AArch64 */
@@ -119,6 +129,11 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 		call_count += ETHOSN_NUM_SMC_CALLS;
 #endif          /* ETHOSN_NPU_DRIVER */
 
+#if RAS_ERR_STATS
+		/* RAS error statistics call */
+		call_count += 1;
+#endif /* RAS_ERR_STATS */
+
 		/* State switch call */
 		call_count += 1;
 
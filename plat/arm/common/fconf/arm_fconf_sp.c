@@ -47,7 +47,7 @@ int fconf_populate_arm_sp(uintptr_t config)
 	/* Assert the node offset point to "arm,sp" compatible property */
 	const char *compatible_str = "arm,sp";
 
-	node = fdt_node_offset_by_compatible(dtb, -1, compatible_str);
+	node = fdtw_node_offset_by_compatible(dtb, -1, compatible_str);
 	if (node < 0) {
 		ERROR("FCONF: Can't find %s in dtb\n", compatible_str);
 		return node;
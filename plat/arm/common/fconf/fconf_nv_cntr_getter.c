@@ -30,7 +30,7 @@ static int fconf_populate_nv_cntrs(uintptr_t config)
 	const void *dtb = (void *)config;
 	const char *compatible_str = "arm, non-volatile-counter";
 
-	node = fdt_node_offset_by_compatible(dtb, -1, compatible_str);
+	node = fdtw_node_offset_by_compatible(dtb, -1, compatible_str);
 	if (node < 0) {
 		ERROR("FCONF: Can't find %s compatible in node\n",
 			compatible_str);
@@ -36,7 +36,7 @@ int fconf_populate_sec_intr_config(uintptr_t config)
 	/* Necessary to work with libfdt APIs */
 	const void *hw_config_dtb = (const void *)config;
 
-	node = fdt_node_offset_by_compatible(hw_config_dtb, -1,
+	node = fdtw_node_offset_by_compatible(hw_config_dtb, -1,
 						"arm,secure_interrupt_desc");
 	if (node < 0) {
 		ERROR("FCONF: Unable to locate node with %s compatible property\n",
@@ -81,6 +81,14 @@ endif
 $(eval $(call assert_boolean,CSS_USE_SCMI_SDS_DRIVER))
 $(eval $(call add_define,CSS_USE_SCMI_SDS_DRIVER))
 
+# Process CSS_SCMI_POSTED_PWR_REQ flag
+# This build option makes the SCMI power domain requests issued on the
+# CPU_ON, CPU_OFF and CPU_SUSPEND paths posted to the SCP instead of waiting
+# for the SCP to acknowledge them.
+CSS_SCMI_POSTED_PWR_REQ		?= 0
+$(eval $(call assert_boolean,CSS_SCMI_POSTED_PWR_REQ))
+$(eval $(call add_define,CSS_SCMI_POSTED_PWR_REQ))
+
 # Process CSS_NON_SECURE_UART flag
 # This undocumented build option is only to enable debug access to the UART
 # from non secure code, which is useful on some platforms.
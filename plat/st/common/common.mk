@@ -195,8 +195,13 @@ endif
 include drivers/auth/mbedtls/mbedtls_x509.mk
 
 COT_DESC_IN_DTB			:=	1
-AUTH_SOURCES			+=	lib/fconf/fconf_cot_getter.c			\
-					lib/fconf/fconf_tbbr_getter.c			\
+COT_DESC_DTS			:=	fdts/stm32mp1-cot-descriptors.dtsi
+ifeq (${COT_DESC_PRECOMPILED},1)
+AUTH_SOURCES			+=	${COT_DESC_C}
+else
+AUTH_SOURCES			+=	lib/fconf/fconf_cot_getter.c
+endif
+AUTH_SOURCES			+=	lib/fconf/fconf_tbbr_getter.c			\
 					plat/st/common/stm32mp_crypto_lib.c
 
 BL2_SOURCES			+=	$(AUTH_SOURCES)					\
@@ -6,12 +6,56 @@
 
 #include <assert.h>
 
+#include <drivers/arm/gic_common.h>
 #include <lib/utils.h>
 
 #include "sdei_private.h"
 
 #define MAP_OFF(_map, _mapping) ((_map) - (_mapping)->map)
 
+/*
+ * Direct-indexed table translating an interrupt number to the index + 1 of the
+ * event mapping bound to it, or 0 if none. SGIs and PPIs index the private
+ * mappings and SPIs the shared ones. Interrupts beyond the table, or mappings
+ * whose index doesn't fit, are looked up by searching the mappings.
+ */
+#define SDEI_INTR_INDEX_SIZE	(MAX_SPI_ID + 1U)
+#define SDEI_INTR_INDEX_NONE	0U
+
+static uint8_t sdei_intr_index[SDEI_INTR_INDEX_SIZE];
+
+static bool is_intr_indexable(unsigned int intr_num)
+{
+	return (intr_num != SDEI_DYN_IRQ) && (intr_num < SDEI_INTR_INDEX_SIZE);
+}
+
+/* Record the interrupt a mapping is bound to in the interrupt index */
+void sdei_intr_index_set(sdei_ev_map_t *map)
+{
+	const sdei_mapping_t *mapping;
+	long int idx;
+
+	if (!is_intr_indexable(map->intr))
+		return;
+
+	mapping = is_event_shared(map) ? SDEI_SHARED_MAPPING() :
+		SDEI_PRIVATE_MAPPING();
+	idx = MAP_OFF(map, mapping);
+	assert((idx >= 0) && ((size_t) idx < mapping->num_maps));
+
+	if (idx >= (long int) UINT8_MAX)
+		return;
+
+	sdei_intr_index[map->intr] = (uint8_t) (idx + 1);
+}
+
+/* Remove an interrupt from the interrupt index */
+void sdei_intr_index_clear(unsigned int intr_num)
+{
+	if (is_intr_indexable(intr_num))
+		sdei_intr_index[intr_num] = SDEI_INTR_INDEX_NONE;
+}
+
 /*
  * Get SDEI entry with the given mapping: on success, returns pointer to SDEI
  * entry. On error, returns NULL.
@@ -60,13 +104,25 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 	const sdei_mapping_t *mapping;
 	sdei_ev_map_t *map;
 	unsigned int i;
+	uint8_t idx;
+
+	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
+
+	/* Bound interrupts are found through the interrupt index */
+	if (is_intr_indexable(intr_num)) {
+		idx = sdei_intr_index[intr_num];
+		if (idx != SDEI_INTR_INDEX_NONE) {
+			map = &mapping->map[idx - 1U];
+			if (map->intr == intr_num)
+				return map;
+		}
+	}
 
 	/*
 	 * Look for a match in private and shared mappings, as requested. This
-	 * is a linear search. However, if the mappings are required to be
-	 * sorted, for large maps, we could consider binary search.
+	 * is a linear search, used for unbound dynamic slots and interrupts
+	 * missing from the index.
 	 */
-	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
 	iterate_mapping(mapping, i, map) {
 		if (map->intr == intr_num)
 			return map;
@@ -140,6 +140,7 @@ static void sdei_class_init(sdei_class_t class)
 			/* Shared mappings must be bound to shared interrupt */
 			assert(plat_ic_is_spi(map->intr) != 0);
 			set_map_bound(map);
+			sdei_intr_index_set(map);
 		}
 
 		init_map(map);
@@ -211,7 +212,10 @@ static void sdei_class_init(sdei_class_t class)
 				 */
 				assert(plat_ic_is_ppi((unsigned) map->intr) != 0);
 				set_map_bound(map);
+				sdei_intr_index_set(map);
 			}
+		} else {
+			sdei_intr_index_set(map);
 		}
 
 		init_map(map);
@@ -764,6 +768,7 @@ static int sdei_interrupt_bind(unsigned int intr_num)
 		if (!is_map_bound(map)) {
 			map->intr = intr_num;
 			set_map_bound(map);
+			sdei_intr_index_set(map);
 			retry = false;
 		}
 		sdei_map_unlock(map);
@@ -821,6 +826,7 @@ static int sdei_interrupt_release(int ev_num)
 		 * during unregister.
 		 */
 
+		sdei_intr_index_clear(map->intr);
 		map->intr = SDEI_DYN_IRQ;
 		clr_map_bound(map);
 	} else {
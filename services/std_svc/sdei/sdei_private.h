@@ -231,6 +231,8 @@ extern sdei_entry_t sdei_shared_event_table[];
 void init_sdei_state(void);
 
 sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared);
+void sdei_intr_index_set(sdei_ev_map_t *map);
+void sdei_intr_index_clear(unsigned int intr_num);
 sdei_ev_map_t *find_event_map(int ev_num);
 sdei_entry_t *get_event_entry(sdei_ev_map_t *map);
 
@@ -134,6 +134,9 @@ struct sp_exec_ctx {
 
 	/* Track the source partition ID to validate a direct response. */
 	uint16_t dir_req_origin_id;
+
+	/* Time the context last started running, for the EL3 profiler. */
+	uint64_t run_start;
 };
 
 /*
@@ -257,6 +260,13 @@ struct sp_exec_ctx *spmc_get_sp_ec(struct secure_partition_desc *sp);
  */
 unsigned int get_ec_index(struct secure_partition_desc *sp);
 
+/*
+ * Helper function to update the runtime state of an execution context of an SP.
+ */
+void spmc_sp_set_rt_state(struct secure_partition_desc *sp,
+			  struct sp_exec_ctx *ec,
+			  enum sp_runtime_states rt_state);
+
 uint64_t spmc_ffa_error_return(void *handle, int error_code);
 
 /*
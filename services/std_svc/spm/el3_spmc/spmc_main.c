@@ -15,6 +15,7 @@
 #include <common/fdt_wrappers.h>
 #include <common/runtime_svc.h>
 #include <common/uuid.h>
+#include <lib/el3_profiler.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/smccc.h>
 #include <lib/utils.h>
@@ -44,6 +45,15 @@
 /* Declare the maximum number of SPs and El3 LPs. */
 #define MAX_SP_LP_PARTITIONS SECURE_PARTITION_COUNT + MAX_EL3_LP_DESCS_COUNT
 
+/*
+ * Maximum number of descriptors returned by one FFA_PARTITION_INFO_GET_REGS
+ * call, in registers x3-x17.
+ */
+#define PARTITION_INFO_REGS_MAX_ENTRIES \
+	((15U * sizeof(uint64_t)) / sizeof(struct ffa_partition_info_v1_1))
+CASSERT(PARTITION_INFO_REGS_MAX_ENTRIES == 5U,
+	assert_partition_info_regs_max_entries);
+
 /*
  * Allocate a secure partition descriptor to describe each SP in the system that
  * does not reside at EL3.
@@ -58,6 +68,23 @@ static struct secure_partition_desc sp_desc[SECURE_PARTITION_COUNT];
  */
 static struct ns_endpoint_desc ns_ep_desc[NS_PARTITION_COUNT];
 
+/*
+ * Partition information descriptors of all the partitions, in the v1.1 and
+ * v1.0 formats, built once by spmc_setup().
+ */
+static struct ffa_partition_info_v1_1 partition_info_v1_1[MAX_SP_LP_PARTITIONS];
+static struct ffa_partition_info_v1_0 partition_info_v1_0[MAX_SP_LP_PARTITIONS];
+static uint32_t partition_info_count;
+
+/*
+ * Number of EL3 Logical Partitions and range of their IDs, computed once by
+ * logical_sp_init() so that looking up a partition that is not a LP does not
+ * scan the LP descriptors.
+ */
+static unsigned int el3_lp_count;
+static uint16_t el3_lp_id_min = UINT16_MAX;
+static uint16_t el3_lp_id_max;
+
 static uint64_t spmc_sp_interrupt_handler(uint32_t id,
 					  uint32_t flags,
 					  void *handle,
@@ -72,6 +99,49 @@ struct el3_lp_desc *get_el3_lp_array(void)
 	return (struct el3_lp_desc *) EL3_LP_DESCS_START;
 }
 
+/*
+ * Helper function to update the runtime state of an execution context of an SP.
+ * The time spent running between entering and leaving the running state is
+ * accounted to the partition by the EL3 profiler, if enabled.
+ */
+void spmc_sp_set_rt_state(struct secure_partition_desc *sp,
+			  struct sp_exec_ctx *ec,
+			  enum sp_runtime_states rt_state)
+{
+	if ((rt_state == RT_STATE_RUNNING) &&
+	    (ec->rt_state != RT_STATE_RUNNING)) {
+		ec->run_start = el3_prof_now();
+	} else if ((rt_state != RT_STATE_RUNNING) &&
+		   (ec->rt_state == RT_STATE_RUNNING)) {
+		el3_prof_record(EL3_PROF_KEY(EL3_PROF_CLASS_SP, sp->sp_id),
+				ec->run_start);
+	}
+
+	ec->rt_state = rt_state;
+}
+
+/*
+ * Helper function to obtain the descriptor of the EL3 Logical Partition with
+ * the given ID, or NULL if there is none.
+ */
+static struct el3_lp_desc *spmc_get_el3_lp_desc(uint16_t id)
+{
+	struct el3_lp_desc *el3_lp_descs;
+
+	if ((id < el3_lp_id_min) || (id > el3_lp_id_max)) {
+		return NULL;
+	}
+
+	el3_lp_descs = get_el3_lp_array();
+	for (unsigned int i = 0U; i < el3_lp_count; i++) {
+		if (el3_lp_descs[i].sp_id == id) {
+			return &el3_lp_descs[i];
+		}
+	}
+
+	return NULL;
+}
+
 /*
  * Helper function to obtain the descriptor of the last SP to whom control was
  * handed to on this physical cpu. Currently, we assume there is only one SP.
@@ -160,8 +230,6 @@ uint64_t spmc_ffa_error_return(void *handle, int error_code)
  ******************************************************************************/
 bool is_ffa_secure_id_valid(uint16_t partition_id)
 {
-	struct el3_lp_desc *el3_lp_descs = get_el3_lp_array();
-
 	/* Ensure the ID is not the invalid partition ID. */
 	if (partition_id == INV_SP_ID) {
 		return false;
@@ -191,10 +259,8 @@ bool is_ffa_secure_id_valid(uint16_t partition_id)
 	}
 
 	/* Ensure we don't clash with any Logical SP's. */
-	for (unsigned int i = 0U; i < EL3_LP_DESCS_COUNT; i++) {
-		if (el3_lp_descs[i].sp_id == partition_id) {
-			return false;
-		}
+	if (spmc_get_el3_lp_desc(partition_id) != NULL) {
+		return false;
 	}
 
 	return true;
@@ -314,10 +380,10 @@ static bool direct_msg_validate_lp_resp(uint16_t origin_id, uint16_t lp_id,
 	}
 
 	/*
-	 * Check the destination ID is valid and ensure the LP is responding to
-	 * the original request.
+	 * Ensure the LP is responding to the original request. The origin was
+	 * validated on receipt of the request so the destination is valid too.
 	 */
-	if ((!direct_msg_validate_dst_id(dst_id)) || (dst_id != origin_id)) {
+	if (dst_id != origin_id) {
 		ERROR("Invalid EL3 LP destination ID (0x%x).\n", dst_id);
 		return false;
 	}
@@ -344,7 +410,7 @@ static uint64_t direct_req_smc_handler(uint32_t smc_fid,
 {
 	uint16_t src_id = ffa_endpoint_source(x1);
 	uint16_t dst_id = ffa_endpoint_destination(x1);
-	struct el3_lp_desc *el3_lp_descs;
+	struct el3_lp_desc *el3_lp_desc;
 	struct secure_partition_desc *sp;
 	unsigned int idx;
 
@@ -362,22 +428,23 @@ static uint64_t direct_req_smc_handler(uint32_t smc_fid,
 					FFA_ERROR_INVALID_PARAMETER);
 	}
 
-	el3_lp_descs = get_el3_lp_array();
-
-	/* Check if the request is destined for a Logical Partition. */
-	for (unsigned int i = 0U; i < MAX_EL3_LP_DESCS_COUNT; i++) {
-		if (el3_lp_descs[i].sp_id == dst_id) {
-			uint64_t ret = el3_lp_descs[i].direct_req(
-						smc_fid, secure_origin, x1, x2,
-						x3, x4, cookie, handle, flags);
-			if (!direct_msg_validate_lp_resp(src_id, dst_id,
-							 handle)) {
-				panic();
-			}
-
-			/* Message checks out. */
-			return ret;
+	/*
+	 * If the request is destined for a Logical Partition, call its handler
+	 * directly. It runs in EL3 on behalf of the caller, so there is no
+	 * execution context to enter and the handler writes its response into
+	 * the caller's context.
+	 */
+	el3_lp_desc = spmc_get_el3_lp_desc(dst_id);
+	if (el3_lp_desc != NULL) {
+		uint64_t ret = el3_lp_desc->direct_req(smc_fid, secure_origin,
+						       x1, x2, x3, x4, cookie,
+						       handle, flags);
+		if (!direct_msg_validate_lp_resp(src_id, dst_id, handle)) {
+			panic();
 		}
+
+		/* Message checks out. */
+		return ret;
 	}
 
 	/*
@@ -426,7 +493,7 @@ static uint64_t direct_req_smc_handler(uint32_t smc_fid,
 	 * Everything checks out so forward the request to the SP after updating
 	 * its state and runtime model.
 	 */
-	sp->ec[idx].rt_state = RT_STATE_RUNNING;
+	spmc_sp_set_rt_state(sp, &sp->ec[idx], RT_STATE_RUNNING);
 	sp->ec[idx].rt_model = RT_MODEL_DIR_REQ;
 	sp->ec[idx].dir_req_origin_id = src_id;
 
@@ -516,7 +583,7 @@ static uint64_t direct_resp_smc_handler(uint32_t smc_fid,
 	}
 
 	/* Update the state of the SP execution context. */
-	sp->ec[idx].rt_state = RT_STATE_WAITING;
+	spmc_sp_set_rt_state(sp, &sp->ec[idx], RT_STATE_WAITING);
 
 	/* Clear the ongoing direct request ID. */
 	sp->ec[idx].dir_req_origin_id = INV_SP_ID;
@@ -605,7 +672,7 @@ static uint64_t msg_wait_handler(uint32_t smc_fid,
 	}
 
 	/* Update the state of the SP execution context. */
-	sp->ec[idx].rt_state = RT_STATE_WAITING;
+	spmc_sp_set_rt_state(sp, &sp->ec[idx], RT_STATE_WAITING);
 
 	/* Resume normal world if a secure interrupt was handled. */
 	if (sp->ec[idx].rt_model == RT_MODEL_INTR) {
@@ -978,6 +1045,40 @@ static int partition_info_get_handler_v1_1(uint32_t *uuid,
 	return 0;
 }
 
+/*
+ * Build the partition information descriptors of all the partitions, in the
+ * formats of each supported FF-A version. The partitions do not change once
+ * set up, so FFA_PARTITION_INFO_GET copies these tables rather than
+ * collating and converting the descriptors on every call.
+ */
+static int partition_info_init(void)
+{
+	uint32_t null_uuid[4] = { 0 };
+	uint32_t index;
+	int ret;
+
+	partition_info_count = 0U;
+	ret = partition_info_get_handler_v1_1(null_uuid, partition_info_v1_1,
+					      MAX_SP_LP_PARTITIONS,
+					      &partition_info_count);
+	if (ret != 0) {
+		return ret;
+	}
+
+	for (index = 0U; index < partition_info_count; index++) {
+		partition_info_v1_0[index].ep_id =
+			partition_info_v1_1[index].ep_id;
+		partition_info_v1_0[index].execution_ctx_count =
+			partition_info_v1_1[index].execution_ctx_count;
+		/* Only report v1.0 properties. */
+		partition_info_v1_0[index].properties =
+			(partition_info_v1_1[index].properties &
+			FFA_PARTITION_INFO_GET_PROPERTIES_V1_0_MASK);
+	}
+
+	return 0;
+}
+
 /*
  * Handle the case where that caller only wants the count of partitions
  * matching a given UUID and does not want the corresponding descriptors
@@ -987,20 +1088,13 @@ static uint32_t partition_info_get_handler_count_only(uint32_t *uuid)
 {
 	uint32_t index = 0;
 	uint32_t partition_count = 0;
-	bool null_uuid = is_null_uuid(uuid);
-	struct el3_lp_desc *el3_lp_descs = get_el3_lp_array();
 
-	/* Deal with Logical Partitions. */
-	for (index = 0U; index < EL3_LP_DESCS_COUNT; index++) {
-		if (null_uuid ||
-		    uuid_match(uuid, el3_lp_descs[index].uuid)) {
-			(partition_count)++;
-		}
+	if (is_null_uuid(uuid)) {
+		return partition_info_count;
 	}
 
-	/* Deal with physical SP's. */
-	for (index = 0U; index < SECURE_PARTITION_COUNT; index++) {
-		if (null_uuid || uuid_match(uuid, sp_desc[index].uuid)) {
+	for (index = 0U; index < partition_info_count; index++) {
+		if (uuid_match(uuid, partition_info_v1_1[index].uuid)) {
 			(partition_count)++;
 		}
 	}
@@ -1008,38 +1102,39 @@ static uint32_t partition_info_get_handler_count_only(uint32_t *uuid)
 }
 
 /*
- * If the caller of the PARTITION_INFO_GET ABI was a v1.0 caller, populate
- * the corresponding descriptor format from the v1.1 descriptor array.
+ * Copy the descriptors of the partitions matching a given UUID, in the format
+ * of the caller's FF-A version, into its RX buffer. The whole table is copied
+ * at once for the NULL UUID. UUIDs are only reported for the NULL UUID.
  */
-static uint64_t partition_info_populate_v1_0(struct ffa_partition_info_v1_1
-					     *partitions,
-					     struct mailbox *mbox,
-					     int partition_count)
+static void partition_info_copy(void *dst, uint32_t *uuid,
+				uint32_t ffa_version, uint32_t partition_count)
 {
+	bool v1_0 = (ffa_version == MAKE_FFA_VERSION(U(1), U(0)));
+	size_t size = v1_0 ? sizeof(struct ffa_partition_info_v1_0) :
+			     sizeof(struct ffa_partition_info_v1_1);
+	const void *table = v1_0 ? (const void *)partition_info_v1_0 :
+				   (const void *)partition_info_v1_1;
+	struct ffa_partition_info_v1_1 *desc;
 	uint32_t index;
-	uint32_t buf_size;
-	uint32_t descriptor_size;
-	struct ffa_partition_info_v1_0 *v1_0_partitions =
-		(struct ffa_partition_info_v1_0 *) mbox->rx_buffer;
 
-	buf_size = mbox->rxtx_page_count * FFA_PAGE_SIZE;
-	descriptor_size = partition_count *
-			  sizeof(struct ffa_partition_info_v1_0);
-
-	if (descriptor_size > buf_size) {
-		return FFA_ERROR_NO_MEMORY;
+	if (is_null_uuid(uuid)) {
+		(void)memcpy(dst, table, partition_count * size);
+		return;
 	}
 
-	for (index = 0U; index < partition_count; index++) {
-		v1_0_partitions[index].ep_id = partitions[index].ep_id;
-		v1_0_partitions[index].execution_ctx_count =
-			partitions[index].execution_ctx_count;
-		/* Only report v1.0 properties. */
-		v1_0_partitions[index].properties =
-			(partitions[index].properties &
-			FFA_PARTITION_INFO_GET_PROPERTIES_V1_0_MASK);
+	for (index = 0U; index < partition_info_count; index++) {
+		if (!uuid_match(uuid, partition_info_v1_1[index].uuid)) {
+			continue;
+		}
+
+		(void)memcpy(dst, (const uint8_t *)table + (index * size),
+			     size);
+		if (!v1_0) {
+			desc = dst;
+			(void)memset(desc->uuid, 0, sizeof(desc->uuid));
+		}
+		dst = (uint8_t *)dst + size;
 	}
-	return 0;
 }
 
 /*
@@ -1074,38 +1169,20 @@ static uint64_t partition_info_get_handler(uint32_t smc_fid,
 	info_get_flags = SMC_GET_GP(handle, CTX_GPREG_X5);
 	count_only = (info_get_flags & FFA_PARTITION_INFO_GET_COUNT_FLAG_MASK);
 
-	/* Handle the case where we don't need to populate the descriptors. */
-	if (count_only) {
-		partition_count = partition_info_get_handler_count_only(uuid);
-		if (partition_count == 0) {
-			return spmc_ffa_error_return(handle,
-						FFA_ERROR_INVALID_PARAMETER);
-		}
-	} else {
-		struct ffa_partition_info_v1_1 partitions[MAX_SP_LP_PARTITIONS];
-
-		/*
-		 * Handle the case where the partition descriptors are required,
-		 * check we have the buffers available and populate the
-		 * appropriate structure version.
-		 */
-
-		/* Obtain the v1.1 format of the descriptors. */
-		ret = partition_info_get_handler_v1_1(uuid, partitions,
-						      MAX_SP_LP_PARTITIONS,
-						      &partition_count);
+	partition_count = partition_info_get_handler_count_only(uuid);
 
-		/* Check if an error occurred during discovery. */
-		if (ret != 0) {
-			goto err;
-		}
-
-		/* If we didn't find any matches the UUID is unknown. */
-		if (partition_count == 0) {
-			ret = FFA_ERROR_INVALID_PARAMETER;
-			goto err;
-		}
+	/* If we didn't find any matches the UUID is unknown. */
+	if (partition_count == 0) {
+		return spmc_ffa_error_return(handle,
+					FFA_ERROR_INVALID_PARAMETER);
+	}
 
+	/*
+	 * Handle the case where the partition descriptors are required,
+	 * check we have the buffers available and populate the appropriate
+	 * structure version.
+	 */
+	if (!count_only) {
 		/* Obtain the partition mailbox RX/TX buffer pair descriptor. */
 		mbox = spmc_get_mbox_desc(secure_origin);
 
@@ -1125,36 +1202,30 @@ static uint64_t partition_info_get_handler(uint32_t smc_fid,
 			goto err_unlock;
 		}
 
-		/* Zero the RX buffer before populating. */
-		(void)memset(mbox->rx_buffer, 0,
-			     mbox->rxtx_page_count * FFA_PAGE_SIZE);
-
-		/*
-		 * Depending on the FF-A version of the requesting partition
-		 * we may need to convert to a v1.0 format otherwise we can copy
-		 * directly.
-		 */
+		/* Ensure the descriptors will fit in the buffer. */
 		if (ffa_version == MAKE_FFA_VERSION(U(1), U(0))) {
-			ret = partition_info_populate_v1_0(partitions,
-							   mbox,
-							   partition_count);
-			if (ret != 0) {
+			if (partition_count *
+			    sizeof(struct ffa_partition_info_v1_0) >
+			    mbox->rxtx_page_count * FFA_PAGE_SIZE) {
+				ret = FFA_ERROR_NO_MEMORY;
 				goto err_unlock;
 			}
 		} else {
-			uint32_t buf_size = mbox->rxtx_page_count *
-					    FFA_PAGE_SIZE;
-
-			/* Ensure the descriptor will fit in the buffer. */
 			size = sizeof(struct ffa_partition_info_v1_1);
-			if (partition_count * size  > buf_size) {
+			if (partition_count * size >
+			    mbox->rxtx_page_count * FFA_PAGE_SIZE) {
 				ret = FFA_ERROR_NO_MEMORY;
 				goto err_unlock;
 			}
-			memcpy(mbox->rx_buffer, partitions,
-			       partition_count * size);
 		}
 
+		/*
+		 * The descriptors are written in full, so the rest of the RX
+		 * buffer does not need to be zeroed.
+		 */
+		partition_info_copy(mbox->rx_buffer, uuid, ffa_version,
+				    partition_count);
+
 		mbox->state = MAILBOX_STATE_FULL;
 		spin_unlock(&mbox->lock);
 	}
@@ -1162,10 +1233,90 @@ static uint64_t partition_info_get_handler(uint32_t smc_fid,
 
 err_unlock:
 	spin_unlock(&mbox->lock);
-err:
 	return spmc_ffa_error_return(handle, ret);
 }
 
+#if MAKE_FFA_VERSION(1, 1) <= FFA_VERSION_COMPILED
+/*
+ * Handler for FFA_PARTITION_INFO_GET_REGS, which returns the descriptors of
+ * the partitions matching a UUID in registers x3-x17, up to
+ * PARTITION_INFO_REGS_MAX_ENTRIES at a time from the start index in x3. This
+ * avoids the use of the RX buffer, and of its lock.
+ */
+static uint64_t partition_info_get_regs_handler(uint32_t smc_fid,
+						bool secure_origin,
+						uint64_t x1,
+						uint64_t x2,
+						uint64_t x3,
+						uint64_t x4,
+						void *cookie,
+						void *handle,
+						uint64_t flags)
+{
+	uint64_t regs[PARTITION_INFO_REGS_MAX_ENTRIES * 3U] = { 0 };
+	const struct ffa_partition_info_v1_1 *desc;
+	uint16_t start_index = (uint16_t)(x3 & 0xFFFFU);
+	uint16_t tag = (uint16_t)((x3 >> 16) & 0xFFFFU);
+	uint32_t match_count = 0U;
+	uint32_t partition_count;
+	uint32_t curr_idx;
+	uint32_t index;
+	uint64_t *xn = regs;
+	uint32_t uuid[4];
+	bool null_uuid;
+
+	uuid[0] = (uint32_t)x1;
+	uuid[1] = (uint32_t)(x1 >> 32);
+	uuid[2] = (uint32_t)x2;
+	uuid[3] = (uint32_t)(x2 >> 32);
+	null_uuid = is_null_uuid(uuid);
+
+	/* The partition information cannot change, so no tag is needed. */
+	if (tag != 0U) {
+		return spmc_ffa_error_return(handle, FFA_ERROR_RETRY);
+	}
+
+	partition_count = partition_info_get_handler_count_only(uuid);
+	if ((partition_count == 0U) || (start_index >= partition_count)) {
+		return spmc_ffa_error_return(handle,
+					     FFA_ERROR_INVALID_PARAMETER);
+	}
+
+	curr_idx = MIN(partition_count - 1U,
+		       (uint32_t)(start_index +
+				  PARTITION_INFO_REGS_MAX_ENTRIES - 1U));
+
+	for (index = 0U; index < partition_info_count; index++) {
+		desc = &partition_info_v1_1[index];
+		if (!null_uuid && !uuid_match(uuid, (uint32_t *)desc->uuid)) {
+			continue;
+		}
+
+		if ((match_count >= start_index) && (match_count <= curr_idx)) {
+			xn[0] = (uint64_t)desc->ep_id |
+				((uint64_t)desc->execution_ctx_count << 16) |
+				((uint64_t)desc->properties << 32);
+			if (null_uuid) {
+				xn[1] = (uint64_t)desc->uuid[0] |
+					((uint64_t)desc->uuid[1] << 32);
+				xn[2] = (uint64_t)desc->uuid[2] |
+					((uint64_t)desc->uuid[3] << 32);
+			}
+			xn += 3;
+		}
+
+		match_count++;
+	}
+
+	SMC_RET18(handle, FFA_SUCCESS_SMC64, 0,
+		  ((uint64_t)sizeof(struct ffa_partition_info_v1_1) << 48) |
+		  ((uint64_t)curr_idx << 16) | (partition_count - 1U),
+		  regs[0], regs[1], regs[2], regs[3], regs[4], regs[5],
+		  regs[6], regs[7], regs[8], regs[9], regs[10], regs[11],
+		  regs[12], regs[13], regs[14]);
+}
+#endif
+
 static uint64_t ffa_feature_success(void *handle, uint32_t arg2)
 {
 	SMC_RET3(handle, FFA_SUCCESS_SMC32, 0, arg2);
@@ -1305,6 +1456,9 @@ static uint64_t ffa_features_handler(uint32_t smc_fid,
 	case FFA_MEM_LEND_SMC64:
 	case FFA_MEM_RECLAIM:
 	case FFA_MEM_FRAG_RX:
+#if MAKE_FFA_VERSION(1, 1) <= FFA_VERSION_COMPILED
+	case FFA_PARTITION_INFO_GET_REGS_SMC64:
+#endif
 
 		if (secure_origin) {
 			return spmc_ffa_error_return(handle,
@@ -1441,7 +1595,7 @@ static uint64_t ffa_run_handler(uint32_t smc_fid,
 	 * Forward the request to the correct SP vCPU after updating
 	 * its state.
 	 */
-	*rt_state = RT_STATE_RUNNING;
+	spmc_sp_set_rt_state(sp, &sp->ec[idx], RT_STATE_RUNNING);
 
 	if (sp->runtime_el == S_EL0) {
 		spin_unlock(&sp->rt_state_lock);
@@ -2081,8 +2235,13 @@ static int32_t logical_sp_init(void)
 		}
 		VERBOSE("Logical SP (0x%x) Initialized\n",
 			      el3_lp_descs[i].sp_id);
+
+		el3_lp_id_min = MIN(el3_lp_id_min, el3_lp_descs[i].sp_id);
+		el3_lp_id_max = MAX(el3_lp_id_max, el3_lp_descs[i].sp_id);
 	}
 
+	el3_lp_count = (unsigned int)EL3_LP_DESCS_COUNT;
+
 	INFO("Logical Secure Partition init completed.\n");
 
 	return rc;
@@ -2126,7 +2285,7 @@ static int32_t sp_init(void)
 	sp = spmc_get_current_sp_ctx();
 	ec = spmc_get_sp_ec(sp);
 	ec->rt_model = RT_MODEL_INIT;
-	ec->rt_state = RT_STATE_RUNNING;
+	spmc_sp_set_rt_state(sp, ec, RT_STATE_RUNNING);
 
 	INFO("Secure Partition (0x%x) init start.\n", sp->sp_id);
 
@@ -2138,7 +2297,7 @@ static int32_t sp_init(void)
 		return 0;
 	}
 
-	ec->rt_state = RT_STATE_WAITING;
+	spmc_sp_set_rt_state(sp, ec, RT_STATE_WAITING);
 	INFO("Secure Partition initialized.\n");
 
 	return 1;
@@ -2232,6 +2391,13 @@ int32_t spmc_setup(void)
 		return ret;
 	}
 
+	/* Build the partition information descriptors. */
+	ret = partition_info_init();
+	if (ret != 0) {
+		ERROR("Failed to build partition information.\n");
+		return ret;
+	}
+
 	/* Register power management hooks with PSCI */
 	psci_register_spd_pm_hook(&spmc_pm);
 
@@ -2318,6 +2484,13 @@ uint64_t spmc_smc_handler(uint32_t smc_fid,
 						  x2, x3, x4, cookie, handle,
 						  flags);
 
+#if MAKE_FFA_VERSION(1, 1) <= FFA_VERSION_COMPILED
+	case FFA_PARTITION_INFO_GET_REGS_SMC64:
+		return partition_info_get_regs_handler(smc_fid, secure_origin,
+						       x1, x2, x3, x4, cookie,
+						       handle, flags);
+#endif
+
 	case FFA_RX_RELEASE:
 		return rx_release_handler(smc_fid, secure_origin, x1, x2, x3,
 					  x4, cookie, handle, flags);
@@ -2416,7 +2589,7 @@ static uint64_t spmc_sp_interrupt_handler(uint32_t id,
 
 	/* Update the runtime model and state of the partition. */
 	ec->rt_model = RT_MODEL_INTR;
-	ec->rt_state = RT_STATE_RUNNING;
+	spmc_sp_set_rt_state(sp, ec, RT_STATE_RUNNING);
 
 	VERBOSE("SP (0x%x) interrupt start on core%u.\n", sp->sp_id, linear_id);
 
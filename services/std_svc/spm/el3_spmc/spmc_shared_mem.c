@@ -518,103 +518,130 @@ spmc_shm_convert_shmem_obj_from_v1_0(struct spmc_shmem_obj *out_obj,
 }
 
 /**
- * spmc_shm_convert_mtd_to_v1_0 - Converts a given v1.1 memory object to
- *                                v1.0 memory object.
- * @out_obj:    The shared memory object to populate the v1.0 descriptor.
- * @orig:       The shared memory object containing the v1.1 descriptor.
+ * spmc_shm_copy_window - Copy the part of a chunk of a descriptor that falls
+ *                        within a window of the descriptor.
+ * @dst:          Buffer holding the window.
+ * @offset:       Offset of the window in the descriptor.
+ * @size:         Size of the window.
+ * @chunk_offset: Offset of the chunk in the descriptor.
+ * @chunk:        Contents of the chunk.
+ * @chunk_size:   Size of the chunk.
+ */
+static void spmc_shm_copy_window(uint8_t *dst, size_t offset, size_t size,
+				 size_t chunk_offset, const void *chunk,
+				 size_t chunk_size)
+{
+	size_t start = MAX(offset, chunk_offset);
+	size_t end = MIN(offset + size, chunk_offset + chunk_size);
+
+	if (start < end) {
+		memcpy(dst + (start - offset),
+		       (const uint8_t *)chunk + (start - chunk_offset),
+		       end - start);
+	}
+}
+
+/**
+ * spmc_shm_populate_v1_0_window - Generate a window of the v1.0 form of a
+ *                                 v1.1 memory object.
+ * @dst:          Buffer to populate with the window.
+ * @orig:         The shared memory object containing the v1.1 descriptor.
+ * @v1_0_size:    Size of the v1.0 descriptor, as returned by
+ *                spmc_shm_get_v1_0_descriptor_size().
+ * @offset:       Offset of the window in the v1.0 descriptor.
+ * @size:         Size of the window.
+ *
+ * The v1.0 descriptor is generated straight into @dst, one chunk at a time,
+ * and chunks outside of the window are skipped. This avoids allocating an
+ * object to hold the whole converted descriptor, which could fail when the
+ * datastore is busy and would require copying the descriptor twice.
  *
  * Return: true if the conversion is successful else false.
  */
 static bool
-spmc_shm_convert_mtd_to_v1_0(struct spmc_shmem_obj *out_obj,
-			     struct spmc_shmem_obj *orig)
+spmc_shm_populate_v1_0_window(void *dst, struct spmc_shmem_obj *orig,
+			      size_t v1_0_size, size_t offset, size_t size)
 {
 	struct ffa_mtd *mtd_orig = &orig->desc;
-	struct ffa_mtd_v1_0 *out = (struct ffa_mtd_v1_0 *) &out_obj->desc;
-	struct ffa_emad_v1_0 *emad_in;
-	struct ffa_emad_v1_0 *emad_array_in;
-	struct ffa_emad_v1_0 *emad_array_out;
-	struct ffa_comp_mrd *mrd_in;
-	struct ffa_comp_mrd *mrd_out;
-
-	size_t mrd_in_offset;
-	size_t mrd_out_offset;
-	size_t emad_out_array_size;
-	size_t mrd_size = 0;
-	size_t orig_desc_size = orig->desc_size;
-
-	/* Populate the v1.0 descriptor format from the v1.1 struct. */
-	out->sender_id = mtd_orig->sender_id;
-	out->memory_region_attributes = mtd_orig->memory_region_attributes;
-	out->flags = mtd_orig->flags;
-	out->handle = mtd_orig->handle;
-	out->tag = mtd_orig->tag;
-	out->emad_count = mtd_orig->emad_count;
-
-	/* Determine the location of the emad array in both descriptors. */
-	emad_array_in = (struct ffa_emad_v1_0 *)
-			((uint8_t *) mtd_orig + mtd_orig->emad_offset);
-	emad_array_out = out->emad;
-
-	/* Copy across the emad structs. */
-	emad_in = emad_array_in;
-	for (unsigned int i = 0U; i < out->emad_count; i++) {
-		/* Bound check for emad array. */
-		if (((uint8_t *)emad_in + sizeof(struct ffa_emad_v1_0)) >
-				((uint8_t *) mtd_orig + orig_desc_size)) {
-			VERBOSE("%s: Invalid mtd structure.\n", __func__);
-			return false;
-		}
-		memcpy(&emad_array_out[i], emad_in,
-		       sizeof(struct ffa_emad_v1_0));
-
-		emad_in +=  mtd_orig->emad_size;
+	struct ffa_mtd_v1_0 out = { 0 };
+	struct ffa_emad_v1_0 emad_out;
+	const uint8_t *emad_in;
+	const struct ffa_comp_mrd *mrd_in;
+	size_t emad_out_offset = offsetof(struct ffa_mtd_v1_0, emad);
+	size_t mrd_in_offset, mrd_out_offset, mrd_size;
+	size_t first, last, end = offset + size;
+
+	assert(end <= v1_0_size);
+
+	/* Check the emad array is within the v1.1 descriptor. */
+	if (mtd_orig->emad_offset + ((size_t)mtd_orig->emad_size *
+				     mtd_orig->emad_count) > orig->desc_size) {
+		VERBOSE("%s: Invalid mtd structure.\n", __func__);
+		return false;
 	}
 
-	/* Place the mrd descriptors after the end of the emad descriptors. */
-	emad_out_array_size = sizeof(struct ffa_emad_v1_0) * out->emad_count;
-
-	mrd_out_offset =  (uint8_t *) out->emad - (uint8_t *) out +
-			  emad_out_array_size;
-
-	mrd_out = (struct ffa_comp_mrd *) ((uint8_t *) out + mrd_out_offset);
-
-	mrd_in_offset = mtd_orig->emad_offset +
-			(mtd_orig->emad_size * mtd_orig->emad_count);
+	/*
+	 * All the emads refer to the same mrd, which is placed right after the
+	 * emads in the v1.0 descriptor.
+	 */
+	emad_in = (const uint8_t *)mtd_orig + mtd_orig->emad_offset;
+	mrd_in_offset = ((const struct ffa_emad_v1_0 *)emad_in)->comp_mrd_offset;
+	if (mrd_in_offset + sizeof(struct ffa_comp_mrd) > orig->desc_size) {
+		ERROR("%s: Invalid mrd structure.\n", __func__);
+		return false;
+	}
 
-	/* Add the size of the composite memory region descriptor. */
-	mrd_size += sizeof(struct ffa_comp_mrd);
+	mrd_in = (const struct ffa_comp_mrd *)((uint8_t *)mtd_orig +
+					       mrd_in_offset);
+	mrd_size = sizeof(struct ffa_comp_mrd) +
+		   (mrd_in->address_range_count * sizeof(struct ffa_cons_mrd));
+	mrd_out_offset = emad_out_offset +
+			 (sizeof(struct ffa_emad_v1_0) * mtd_orig->emad_count);
+	if ((mrd_in_offset + mrd_size > orig->desc_size) ||
+	    (mrd_out_offset + mrd_size != v1_0_size)) {
+		ERROR("%s: Invalid mrd structure.\n", __func__);
+		return false;
+	}
 
-	/* Find the mrd descriptor. */
-	mrd_in = (struct ffa_comp_mrd *) ((uint8_t *) mtd_orig + mrd_in_offset);
+	/* Populate the v1.0 descriptor header from the v1.1 one. */
+	if (offset < emad_out_offset) {
+		out.sender_id = mtd_orig->sender_id;
+		out.memory_region_attributes =
+			mtd_orig->memory_region_attributes;
+		out.flags = mtd_orig->flags;
+		out.handle = mtd_orig->handle;
+		out.tag = mtd_orig->tag;
+		out.emad_count = mtd_orig->emad_count;
 
-	/* Add the size of the constituent memory region descriptors. */
-	mrd_size += mrd_in->address_range_count * sizeof(struct ffa_cons_mrd);
+		spmc_shm_copy_window(dst, offset, size, 0U, &out,
+				     emad_out_offset);
+	}
 
 	/*
-	 * Update the offset in the emads by the delta between the input and
-	 * output addresses.
+	 * Copy across the emads in the window, updating the offset of the
+	 * mrd by the delta between its input and output locations.
 	 */
-	emad_in = emad_array_in;
+	first = (offset > emad_out_offset) ?
+		(offset - emad_out_offset) / sizeof(struct ffa_emad_v1_0) : 0U;
+	last = (end > emad_out_offset) ?
+	       MIN((size_t)mtd_orig->emad_count,
+		   div_round_up(end - emad_out_offset,
+				sizeof(struct ffa_emad_v1_0))) : 0U;
+	for (size_t i = first; i < last; i++) {
+		emad_in = (const uint8_t *)mtd_orig + mtd_orig->emad_offset +
+			  (i * mtd_orig->emad_size);
 
-	for (unsigned int i = 0U; i < out->emad_count; i++) {
-		emad_array_out[i].comp_mrd_offset = emad_in->comp_mrd_offset +
-						    (mrd_out_offset -
-						     mrd_in_offset);
-		emad_in +=  mtd_orig->emad_size;
-	}
+		memcpy(&emad_out, emad_in, sizeof(emad_out));
+		emad_out.comp_mrd_offset += mrd_out_offset - mrd_in_offset;
 
-	/* Verify that we stay within bound of the memory descriptors. */
-	if ((uintptr_t)((uint8_t *) mrd_in + mrd_size) >
-	     (uintptr_t)((uint8_t *) mtd_orig + orig->desc_size) ||
-	    ((uintptr_t)((uint8_t *) mrd_out + mrd_size) >
-	     (uintptr_t)((uint8_t *) out + out_obj->desc_size))) {
-		ERROR("%s: Invalid mrd structure.\n", __func__);
-		return false;
+		spmc_shm_copy_window(dst, offset, size, emad_out_offset +
+				     (i * sizeof(emad_out)), &emad_out,
+				     sizeof(emad_out));
 	}
 
 	/* Copy the mrd descriptors directly. */
-	memcpy(mrd_out, mrd_in, mrd_size);
+	spmc_shm_copy_window(dst, offset, size, mrd_out_offset, mrd_in,
+			     mrd_size);
 
 	return true;
 }
@@ -632,16 +659,12 @@ spmc_shm_convert_mtd_to_v1_0(struct spmc_shmem_obj *out_obj,
  *                  descriptor.
  *
  * Return: 0 if conversion and population succeeded.
- * Note: This function invalidates the reference to @orig therefore
- * `spmc_shmem_obj_lookup` must be called if further usage is required.
  */
 static uint32_t
 spmc_populate_ffa_v1_0_descriptor(void *dst, struct spmc_shmem_obj *orig_obj,
 				 size_t buf_size, size_t offset,
 				 size_t *copy_size, size_t *v1_0_desc_size)
 {
-		struct spmc_shmem_obj *v1_0_obj;
-
 		/* Calculate the size that the v1.0 descriptor will require. */
 		*v1_0_desc_size = spmc_shm_get_v1_0_descriptor_size(
 					&orig_obj->desc, orig_obj->desc_size);
@@ -652,29 +675,18 @@ spmc_populate_ffa_v1_0_descriptor(void *dst, struct spmc_shmem_obj *orig_obj,
 			return FFA_ERROR_INVALID_PARAMETER;
 		}
 
-		/* Get a new obj to store the v1.0 descriptor. */
-		v1_0_obj = spmc_shmem_obj_alloc(&spmc_shmem_obj_state,
-						*v1_0_desc_size);
-
-		if (!v1_0_obj) {
-			return FFA_ERROR_NO_MEMORY;
-		}
-
-		/* Perform the conversion from v1.1 to v1.0. */
-		if (!spmc_shm_convert_mtd_to_v1_0(v1_0_obj, orig_obj)) {
-			spmc_shmem_obj_free(&spmc_shmem_obj_state, v1_0_obj);
+		if (offset >= *v1_0_desc_size) {
 			return FFA_ERROR_INVALID_PARAMETER;
 		}
 
-		*copy_size = MIN(v1_0_obj->desc_size - offset, buf_size);
-		memcpy(dst, (uint8_t *) &v1_0_obj->desc + offset, *copy_size);
+		*copy_size = MIN(*v1_0_desc_size - offset, buf_size);
 
-		/*
-		 * We're finished with the v1.0 descriptor for now so free it.
-		 * Note that this will invalidate any references to the v1.1
-		 * descriptor.
-		 */
-		spmc_shmem_obj_free(&spmc_shmem_obj_state, v1_0_obj);
+		/* Generate only the requested part of the v1.0 descriptor. */
+		if (!spmc_shm_populate_v1_0_window(dst, orig_obj,
+						   *v1_0_desc_size, offset,
+						   *copy_size)) {
+			return FFA_ERROR_INVALID_PARAMETER;
+		}
 
 		return 0;
 }
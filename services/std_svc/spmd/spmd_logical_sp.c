@@ -12,6 +12,9 @@
 #include <common/debug.h>
 #include <common/uuid.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/pmf/pmf.h>
+#include <lib/spinlock.h>
+#include <plat/common/platform.h>
 #include <services/el3_spmd_logical_sp.h>
 #include <services/spmc_svc.h>
 #include <smccc_helpers.h>
@@ -29,10 +32,48 @@
 		  sizeof(struct ffa_partition_info_v1_1))
 CASSERT(MAX_INFO_REGS_ENTRIES_PER_CALL == 5, assert_too_many_info_reg_entries);
 
+/*
+ * Maximum number of partition descriptors reported by the SPMC that the SPMD
+ * caches. Discovery requests are always forwarded to the SPMC when it reports
+ * more partitions than this.
+ */
+#define SPMD_SPMC_PARTITION_CACHE_SIZE	U(32)
+
 #if ENABLE_SPMD_LP
 static bool is_spmd_lp_inited;
 static bool is_spmc_inited;
 
+/*
+ * Partition descriptors reported by the SPMC for a NULL UUID discovery request.
+ * The cache is filled on the first discovery request issued by an SPMD logical
+ * partition and invalidated whenever the SPMC state changes. If the SPMC
+ * answer can't be cached, this is remembered until the next SPMC state change
+ * so that later requests are forwarded straight away.
+ *
+ * spmc_partition_cache_lock protects the state and generation of the cache.
+ * It is never held across an entry into the SPMC: the descriptors are written
+ * by the only CPU filling the cache while it is invalid, and published by
+ * making it valid if no invalidation happened in the meantime.
+ */
+#define SPMC_PARTITION_CACHE_INVALID		U(0)
+#define SPMC_PARTITION_CACHE_FILLING		U(1)
+#define SPMC_PARTITION_CACHE_VALID		U(2)
+#define SPMC_PARTITION_CACHE_UNCACHEABLE	U(3)
+
+static struct ffa_partition_info_v1_1
+	spmc_partitions[SPMD_SPMC_PARTITION_CACHE_SIZE];
+static uint16_t spmc_partition_count;
+static unsigned int spmc_partition_cache_state;
+static unsigned int spmc_partition_cache_gen;
+static spinlock_t spmc_partition_cache_lock;
+
+/* Per-CPU count of discovery requests answered from the cache or forwarded. */
+#define SPMD_PI_STAT_CACHED	U(0)
+#define SPMD_PI_STAT_FORWARDED	U(1)
+#define SPMD_PI_STAT_COUNT	U(2)
+
+static uint64_t partition_info_stats[PLATFORM_CORE_COUNT][SPMD_PI_STAT_COUNT];
+
 /*
  * Helper function to obtain the array storing the EL3
  * SPMD Logical Partition descriptors.
@@ -282,6 +323,195 @@ static inline void spmd_pack_lp_uuid(uint64_t *xn_1, uint64_t *xn_2,
 	*xn_2 = (uint64_t)uuid[2];
 	*xn_2 |= (uint64_t)uuid[3] << 32;
 }
+
+static void spmd_spmc_partition_cache_invalidate(void)
+{
+	spin_lock(&spmc_partition_cache_lock);
+	/* A cache being filled is discarded when it is published. */
+	if (spmc_partition_cache_state != SPMC_PARTITION_CACHE_FILLING) {
+		spmc_partition_cache_state = SPMC_PARTITION_CACHE_INVALID;
+	}
+	spmc_partition_cache_gen++;
+	spin_unlock(&spmc_partition_cache_lock);
+}
+
+/*
+ * Enter the SPMC with an FFA_PARTITION_INFO_GET_REGS request and return its
+ * response in retval.
+ */
+static void spmd_forward_partition_info_get(spmd_spm_core_context_t *ctx,
+					    const uint32_t target_uuid[4],
+					    const uint16_t start_index,
+					    const uint16_t tag,
+					    struct ffa_value *retval)
+{
+	uint64_t rc = UINT64_MAX;
+
+	/* Save the non-secure context before entering SPMC */
+	cm_el1_sysregs_context_save(NON_SECURE);
+#if SPMD_SPM_AT_SEL2
+	cm_el2_sysregs_context_save(NON_SECURE);
+#endif
+
+	spmd_build_ffa_info_get_regs(ctx, target_uuid, start_index, tag);
+	spmd_logical_sp_set_info_regs_ongoing(ctx);
+
+	rc = spmd_spm_core_sync_entry(ctx);
+	if (rc != 0ULL) {
+		ERROR("%s failed (%lx) on CPU%u\n", __func__, rc,
+		      plat_my_core_pos());
+		panic();
+	}
+
+	spmd_logical_sp_reset_info_regs_ongoing(ctx);
+	spmd_encode_ctx_to_ffa_value(ctx, retval);
+
+	assert(is_ffa_error(retval) || is_ffa_success(retval));
+
+	cm_el1_sysregs_context_restore(NON_SECURE);
+#if SPMD_SPM_AT_SEL2
+	cm_el2_sysregs_context_restore(NON_SECURE);
+#endif
+	cm_set_next_eret_context(NON_SECURE);
+}
+
+/*
+ * Query the SPMC for all its partitions, walking the start index until the
+ * last descriptor is returned, and record them in the partition cache. The
+ * cache is marked uncacheable if the SPMC reports an error or too many
+ * partitions. Nothing is done if the cache is not invalid, or if another CPU
+ * is filling it.
+ */
+static void spmd_spmc_partition_cache_populate(spmd_spm_core_context_t *ctx)
+{
+	const uint32_t null_uuid[4] = { 0 };
+	unsigned int state = SPMC_PARTITION_CACHE_UNCACHEABLE;
+	struct ffa_value ret;
+	uint16_t start_index = 0U;
+	uint16_t curr_idx;
+	uint16_t last_idx;
+	unsigned int gen;
+
+	spin_lock(&spmc_partition_cache_lock);
+	if (spmc_partition_cache_state != SPMC_PARTITION_CACHE_INVALID) {
+		spin_unlock(&spmc_partition_cache_lock);
+		return;
+	}
+	spmc_partition_cache_state = SPMC_PARTITION_CACHE_FILLING;
+	gen = spmc_partition_cache_gen;
+	spin_unlock(&spmc_partition_cache_lock);
+
+	do {
+		spmd_forward_partition_info_get(ctx, null_uuid, start_index,
+						0U, &ret);
+		if (!is_ffa_success(&ret)) {
+			VERBOSE("SPMC partition discovery failed, not caching.\n");
+			goto out;
+		}
+
+		curr_idx = ffa_partition_info_regs_get_curr_idx(&ret);
+		last_idx = ffa_partition_info_regs_get_last_idx(&ret);
+
+		if ((last_idx >= SPMD_SPMC_PARTITION_CACHE_SIZE) ||
+		    (curr_idx < start_index) || (curr_idx > last_idx) ||
+		    ((curr_idx - start_index) >= MAX_INFO_REGS_ENTRIES_PER_CALL)) {
+			VERBOSE("SPMC partition info (%u/%u) not cacheable.\n",
+				curr_idx, last_idx);
+			goto out;
+		}
+
+		for (uint16_t idx = start_index; idx <= curr_idx; idx++) {
+			(void)ffa_partition_info_regs_get_part_info(&ret,
+					(uint8_t)(idx - start_index),
+					&spmc_partitions[idx]);
+		}
+
+		start_index = curr_idx + 1U;
+	} while (curr_idx < last_idx);
+
+	spmc_partition_count = last_idx + 1U;
+	state = SPMC_PARTITION_CACHE_VALID;
+
+out:
+	/*
+	 * Publish the outcome unless the SPMC state changed while the cache
+	 * was being filled, in which case the cache is invalid again.
+	 */
+	spin_lock(&spmc_partition_cache_lock);
+	assert(spmc_partition_cache_state == SPMC_PARTITION_CACHE_FILLING);
+	if (spmc_partition_cache_gen != gen) {
+		state = SPMC_PARTITION_CACHE_INVALID;
+	}
+	spmc_partition_cache_state = state;
+	spin_unlock(&spmc_partition_cache_lock);
+}
+
+/*
+ * Encode a FFA_PARTITION_INFO_GET_REGS response from the partition cache,
+ * restricted to the partitions matching target_uuid unless it is the NULL UUID.
+ */
+static void spmd_spmc_partition_cache_lookup(const uint32_t target_uuid[4],
+					     const uint16_t start_index,
+					     struct ffa_value *retval)
+{
+	bool uuid_is_null = is_null_uuid((uint32_t *)target_uuid);
+	uint64_t *arg_ptrs = (uint64_t *)retval + 3;
+	uint16_t match_count = 0U;
+	uint16_t curr_idx;
+	uint16_t max_idx;
+
+	for (uint16_t idx = 0U; idx < spmc_partition_count; idx++) {
+		if (uuid_is_null ||
+		    uuid_match((uint32_t *)target_uuid,
+			       spmc_partitions[idx].uuid)) {
+			match_count++;
+		}
+	}
+
+	if (match_count == 0U) {
+		spmd_encode_ffa_error(retval, FFA_ERROR_INVALID_PARAMETER);
+		return;
+	}
+
+	if (start_index >= match_count) {
+		spmd_encode_ffa_error(retval, FFA_ERROR_INVALID_PARAMETER);
+		return;
+	}
+
+	max_idx = match_count - 1U;
+	curr_idx = MIN(max_idx, (uint16_t)(start_index +
+		       MAX_INFO_REGS_ENTRIES_PER_CALL - 1U));
+
+	retval->func = FFA_SUCCESS_SMC64;
+	retval->arg2 = (uint64_t)((sizeof(struct ffa_partition_info_v1_1) &
+				   0xFFFFU) << 48);
+	retval->arg2 |= (uint64_t)curr_idx << 16;
+	retval->arg2 |= (uint64_t)max_idx;
+
+	match_count = 0U;
+	for (uint16_t idx = 0U; idx < spmc_partition_count; idx++) {
+		struct ffa_partition_info_v1_1 *info = &spmc_partitions[idx];
+
+		if (!uuid_is_null &&
+		    !uuid_match((uint32_t *)target_uuid, info->uuid)) {
+			continue;
+		}
+
+		if ((match_count >= start_index) && (match_count <= curr_idx)) {
+			spmd_pack_lp_count_props(arg_ptrs, info->ep_id,
+						 info->execution_ctx_count,
+						 info->properties);
+			arg_ptrs++;
+			if (uuid_is_null) {
+				spmd_pack_lp_uuid(arg_ptrs, (arg_ptrs + 1),
+						  info->uuid);
+			}
+			arg_ptrs += 2;
+		}
+
+		match_count++;
+	}
+}
 #endif
 
 /*
@@ -338,6 +568,7 @@ int32_t spmd_logical_sp_init(void)
 void spmd_logical_sp_set_spmc_initialized(void)
 {
 #if ENABLE_SPMD_LP
+	spmd_spmc_partition_cache_invalidate();
 	is_spmc_inited = true;
 #endif
 }
@@ -346,9 +577,35 @@ void spmd_logical_sp_set_spmc_failure(void)
 {
 #if ENABLE_SPMD_LP
 	is_spmc_inited = false;
+	spmd_spmc_partition_cache_invalidate();
 #endif
 }
 
+#if ENABLE_SPMD_LP && ENABLE_PMF
+/*
+ * PMF interface to the counts of partition discovery requests issued by SPMD
+ * logical partitions on a CPU: timestamp ID 0 returns the number of requests
+ * answered from the SPMD cache and ID 1 the number forwarded to the SPMC.
+ */
+static unsigned long long spmd_partition_info_get_stat(unsigned int tid,
+						       u_register_t mpidr,
+						       unsigned int flags)
+{
+	int cpu = plat_core_pos_by_mpidr(mpidr);
+
+	tid &= PMF_TID_MASK;
+	if ((cpu < 0) || (tid >= SPMD_PI_STAT_COUNT)) {
+		return 0ULL;
+	}
+
+	return partition_info_stats[cpu][tid];
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(spmd_pi_svc, PMF_ARM_TIF_IMPL_ID,
+	PMF_SPMD_PI_SVC_ID, SPMD_PI_STAT_COUNT, NULL,
+	spmd_partition_info_get_stat)
+#endif /* ENABLE_SPMD_LP && ENABLE_PMF */
+
 /*
  * This function takes an ffa_value structure populated with partition
  * information from an FFA_PARTITION_INFO_GET_REGS ABI call, extracts
@@ -504,8 +761,8 @@ bool spmd_el3_invoke_partition_info_get(
 				struct ffa_value *retval)
 {
 #if ENABLE_SPMD_LP
-	uint64_t rc = UINT64_MAX;
 	spmd_spm_core_context_t *ctx = spmd_get_context();
+	unsigned int linear_id = plat_my_core_pos();
 
 	if (retval == NULL) {
 		return false;
@@ -527,32 +784,25 @@ bool spmd_el3_invoke_partition_info_get(
 		return true;
 	}
 
-	/* Save the non-secure context before entering SPMC */
-	cm_el1_sysregs_context_save(NON_SECURE);
-#if SPMD_SPM_AT_SEL2
-	cm_el2_sysregs_context_save(NON_SECURE);
-#endif
-
-	spmd_build_ffa_info_get_regs(ctx, target_uuid, start_index, tag);
-	spmd_logical_sp_set_info_regs_ongoing(ctx);
-
-	rc = spmd_spm_core_sync_entry(ctx);
-	if (rc != 0ULL) {
-		ERROR("%s failed (%lx) on CPU%u\n", __func__, rc,
-		      plat_my_core_pos());
-		panic();
+	/*
+	 * Partition descriptors only change with the SPMC state, answer from
+	 * the cache whenever possible to save a world switch.
+	 */
+	spmd_spmc_partition_cache_populate(ctx);
+
+	spin_lock(&spmc_partition_cache_lock);
+	if (spmc_partition_cache_state == SPMC_PARTITION_CACHE_VALID) {
+		spmd_spmc_partition_cache_lookup(target_uuid, start_index,
+						 retval);
+		spin_unlock(&spmc_partition_cache_lock);
+		partition_info_stats[linear_id][SPMD_PI_STAT_CACHED]++;
+		return true;
 	}
+	spin_unlock(&spmc_partition_cache_lock);
 
-	spmd_logical_sp_reset_info_regs_ongoing(ctx);
-	spmd_encode_ctx_to_ffa_value(ctx, retval);
-
-	assert(is_ffa_error(retval) || is_ffa_success(retval));
-
-	cm_el1_sysregs_context_restore(NON_SECURE);
-#if SPMD_SPM_AT_SEL2
-	cm_el2_sysregs_context_restore(NON_SECURE);
-#endif
-	cm_set_next_eret_context(NON_SECURE);
+	spmd_forward_partition_info_get(ctx, target_uuid, start_index, tag,
+					retval);
+	partition_info_stats[linear_id][SPMD_PI_STAT_FORWARDED]++;
 	return true;
 #else
 	return false;
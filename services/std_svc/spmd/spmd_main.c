@@ -382,6 +382,28 @@ static void spmd_do_sec_cpy(uintptr_t root_base_addr, uintptr_t sec_base_addr,
 	assert(sec_base_addr != 0UL);
 	assert(size != 0UL);
 
+#if PLAT_XLAT_CPU_WINDOWS
+	/*
+	 * Use the scratch window of this CPU if both regions fit in it, as it
+	 * avoids adding and removing two dynamic regions.
+	 */
+	void *root_va, *sec_va;
+
+	root_va = xlat_cpu_window_map(root_base_addr, size,
+				      MT_RO_DATA | MT_ROOT);
+	if (root_va != NULL) {
+		sec_va = xlat_cpu_window_map(sec_base_addr, size,
+					     MT_RW_DATA | MT_SECURE);
+		if (sec_va != NULL) {
+			(void)memcpy(sec_va, root_va, size);
+			xlat_cpu_window_unmap(sec_va, size);
+			xlat_cpu_window_unmap(root_va, size);
+			return;
+		}
+		xlat_cpu_window_unmap(root_va, size);
+	}
+#endif /* PLAT_XLAT_CPU_WINDOWS */
+
 	/* Map the memory with required attributes */
 	rc = spmd_dynamic_map_mem(root_base_addr, size, MT_RO_DATA | MT_ROOT,
 				  &root_base_addr_align,
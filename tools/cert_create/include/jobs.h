@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+/* Function called to run the job 'idx' */
+typedef void (*job_fn_t)(int idx);
+
+int jobs_run(int num_jobs, const int *deps, job_fn_t fn, int num_threads,
+	     double *times);
+
+#endif /* JOBS_H */
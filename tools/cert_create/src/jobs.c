@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "debug.h"
+#include "jobs.h"
+
+enum job_state {
+	JOB_PENDING,
+	JOB_RUNNING,
+	JOB_DONE
+};
+
+static pthread_mutex_t jobs_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobs_cond = PTHREAD_COND_INITIALIZER;
+static enum job_state *jobs_state;
+static const int *jobs_deps;
+static int jobs_num;
+static job_fn_t jobs_fn;
+static double *jobs_times;
+
+static double get_time(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Return the index of the first pending job whose dependency is done, -1 if
+ * every job has been started or -2 if the pending jobs have to wait.
+ */
+static int get_ready_job(void)
+{
+	int i, ret = -1;
+
+	for (i = 0; i < jobs_num; i++) {
+		if (jobs_state[i] != JOB_PENDING) {
+			continue;
+		}
+		if ((jobs_deps[i] < 0) || (jobs_state[jobs_deps[i]] == JOB_DONE)) {
+			return i;
+		}
+		ret = -2;
+	}
+
+	return ret;
+}
+
+static void run_job(int idx)
+{
+	double start = 0;
+
+	if (jobs_times != NULL) {
+		start = get_time();
+	}
+
+	jobs_fn(idx);
+
+	if (jobs_times != NULL) {
+		jobs_times[idx] = get_time() - start;
+	}
+}
+
+static void *jobs_worker(void *arg)
+{
+	int idx;
+
+	(void)arg;
+
+	pthread_mutex_lock(&jobs_lock);
+	while ((idx = get_ready_job()) != -1) {
+		if (idx == -2) {
+			pthread_cond_wait(&jobs_cond, &jobs_lock);
+			continue;
+		}
+
+		jobs_state[idx] = JOB_RUNNING;
+		pthread_mutex_unlock(&jobs_lock);
+
+		run_job(idx);
+
+		pthread_mutex_lock(&jobs_lock);
+		jobs_state[idx] = JOB_DONE;
+		pthread_cond_broadcast(&jobs_cond);
+	}
+	pthread_mutex_unlock(&jobs_lock);
+
+	return NULL;
+}
+
+/*
+ * Run the 'num_jobs' jobs on up to 'num_threads' threads. The job 'i' only
+ * starts once the job 'deps[i]' is done (no dependency if negative), so
+ * dependencies must point to jobs with a lower index. The duration of each
+ * job is stored in 'times' if not NULL.
+ *
+ * Returns 0 on success.
+ */
+int jobs_run(int num_jobs, const int *deps, job_fn_t fn, int num_threads,
+	     double *times)
+{
+	pthread_t *threads;
+	int i, ret = 0;
+
+	jobs_num = num_jobs;
+	jobs_deps = deps;
+	jobs_fn = fn;
+	jobs_times = times;
+
+	/* Sequential mode: jobs are run in order */
+	if (num_threads <= 1) {
+		for (i = 0; i < num_jobs; i++) {
+			run_job(i);
+		}
+		return 0;
+	}
+
+	jobs_state = calloc(num_jobs, sizeof(*jobs_state));
+	threads = calloc(num_threads, sizeof(*threads));
+	if ((jobs_state == NULL) || (threads == NULL)) {
+		ERROR("Cannot allocate the job pool\n");
+		ret = -1;
+		goto END;
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		if (pthread_create(&threads[i], NULL, jobs_worker, NULL) != 0) {
+			ERROR("Cannot create worker thread\n");
+			ret = -1;
+			break;
+		}
+	}
+
+	/* Wait for the started workers, they run all the jobs */
+	while (--i >= 0) {
+		pthread_join(threads[i], NULL);
+	}
+
+END:
+	free(threads);
+	free(jobs_state);
+	jobs_state = NULL;
+
+	return ret;
+}
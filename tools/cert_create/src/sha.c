@@ -14,7 +14,7 @@
 #include <openssl/sha.h>
 #endif
 
-#define BUFFER_SIZE	256
+#define BUFFER_SIZE	65536
 
 #if USING_OPENSSL3
 static int get_algorithm_nid(int hash_alg)
@@ -0,0 +1,556 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+This script is invoked by the Make system when COT_DESC_PRECOMPILED=1. It
+converts a chain of trust described in device tree, following the binding in
+docs/components/cot-binding.rst, into a C file holding the same static tables
+as a CoT written in C (e.g. drivers/auth/tbbr/tbbr_cot_bl2.c).
+
+The input is the CoT DTS after it has been run through the C preprocessor, so
+that image identifiers and OIDs are already expanded. The CoT is checked while
+it is converted:
+  - every image and certificate has an image-id, and image-ids are unique;
+  - every reference points to an existing node;
+  - certificates other than root certificates have a parent and a signing-key;
+  - images have a parent and a hash;
+  - parents are certificates, and every chain ends at a root certificate.
+
+usage: cot_dt2c.py [--source <CoT DTS>] <preprocessed CoT DTS> <output C file>
+
+--source gives the name of the original CoT DTS, which is recorded in the
+header of the generated file.
+"""
+
+import argparse
+import ast
+import operator
+import re
+import sys
+
+
+class CotError(Exception):
+    pass
+
+
+class Node:
+    def __init__(self, name):
+        self.name = name
+        self.props = {}
+        self.children = {}
+
+
+# Tokens of the DTS source language, in match order.
+TOKEN_RE = re.compile(
+    r"""
+    (?P<space>\s+|//[^\n]*|/\*.*?\*/)
+  | (?P<directive>/[a-z-]+/)
+  | (?P<string>"(?:[^"\\]|\\.)*")
+  | (?P<ref>&(?:\{[^}]*\}|[A-Za-z_][A-Za-z0-9_]*))
+  | (?P<label>[A-Za-z_][A-Za-z0-9_]*:)
+  | (?P<name>[A-Za-z0-9_\#][A-Za-z0-9,._+*\#?@-]*)
+  | (?P<punct>[{};=<>\[\](),])
+  | (?P<expr>[-+*/%~!|^&?:])
+    """,
+    re.VERBOSE | re.DOTALL,
+)
+
+BINOPS = {
+    ast.Add: operator.add,
+    ast.Sub: operator.sub,
+    ast.Mult: operator.mul,
+    ast.FloorDiv: operator.floordiv,
+    ast.Mod: operator.mod,
+    ast.LShift: operator.lshift,
+    ast.RShift: operator.rshift,
+    ast.BitOr: operator.or_,
+    ast.BitAnd: operator.and_,
+    ast.BitXor: operator.xor,
+}
+
+UNARYOPS = {
+    ast.USub: operator.neg,
+    ast.UAdd: operator.pos,
+    ast.Invert: operator.invert,
+}
+
+
+def eval_expr(text):
+    """Evaluate an integer C expression, as found in DTS cells."""
+    text = re.sub(r"\b(0[xX][0-9a-fA-F]+|[0-9]+)[uUlL]*\b", r"\1", text)
+    text = text.replace("/", "//")
+
+    def _eval(node):
+        if isinstance(node, ast.Expression):
+            return _eval(node.body)
+        if isinstance(node, ast.Constant) and isinstance(node.value, int):
+            return node.value
+        if isinstance(node, ast.BinOp) and type(node.op) in BINOPS:
+            return BINOPS[type(node.op)](_eval(node.left), _eval(node.right))
+        if isinstance(node, ast.UnaryOp) and type(node.op) in UNARYOPS:
+            return UNARYOPS[type(node.op)](_eval(node.operand))
+        raise CotError(f"unsupported expression '{text}'")
+
+    try:
+        return _eval(ast.parse(text, mode="eval")) & 0xFFFFFFFF
+    except SyntaxError:
+        raise CotError(f"invalid expression '{text}'") from None
+
+
+class DtsParser:
+    """Parser for the subset of the DTS language used to describe a CoT."""
+
+    def __init__(self, text):
+        self.tokens = []
+        pos = 0
+
+        while pos < len(text):
+            m = TOKEN_RE.match(text, pos)
+            if m is None:
+                line = text.count("\n", 0, pos) + 1
+                raise CotError(f"line {line}: unexpected '{text[pos]}'")
+            if m.lastgroup != "space":
+                self.tokens.append((m.lastgroup, m.group()))
+            pos = m.end()
+
+        self.pos = 0
+        self.root = Node("/")
+        self.labels = {}
+
+    def peek(self):
+        if self.pos < len(self.tokens):
+            return self.tokens[self.pos]
+        return (None, None)
+
+    def next(self):
+        tok = self.peek()
+        if tok[0] is None:
+            raise CotError("unexpected end of file")
+        self.pos += 1
+        return tok
+
+    def expect(self, value):
+        kind, tok = self.next()
+        if tok != value:
+            raise CotError(f"expected '{value}', got '{tok}'")
+
+    def parse(self):
+        while self.peek()[0] is not None:
+            kind, tok = self.peek()
+
+            if kind == "directive":
+                self.next()
+                if tok not in ("/dts-v1/", "/plugin/"):
+                    raise CotError(f"unsupported directive {tok}")
+                self.expect(";")
+            elif kind == "ref":
+                # Extend a labelled node: &label { ... };
+                self.next()
+                self.parse_body(self.lookup(tok[1:]))
+                self.expect(";")
+            else:
+                labels = self.parse_labels()
+                kind, name = self.next()
+                # Nodes described outside of a root node, as in a .dtsi
+                # fragment, are children of the root node.
+                node = self.root if name == "/" else self.child(self.root, name)
+                self.add_labels(labels, node)
+                self.parse_body(node)
+                self.expect(";")
+
+        return self.root
+
+    def parse_labels(self):
+        labels = []
+        while self.peek()[0] == "label":
+            labels.append(self.next()[1][:-1])
+        return labels
+
+    def add_labels(self, labels, node):
+        for label in labels:
+            if self.labels.get(label, node) is not node:
+                raise CotError(f"duplicate label '{label}'")
+            self.labels[label] = node
+
+    @staticmethod
+    def child(parent, name):
+        if name not in parent.children:
+            parent.children[name] = Node(name)
+        return parent.children[name]
+
+    def lookup(self, ref):
+        if ref.startswith("{"):
+            raise CotError(f"path references are not supported: &{ref}")
+        if ref not in self.labels:
+            raise CotError(f"reference to unknown label '{ref}'")
+        return self.labels[ref]
+
+    def parse_body(self, node):
+        self.expect("{")
+
+        while self.peek()[1] != "}":
+            labels = self.parse_labels()
+            kind, name = self.next()
+            if kind != "name":
+                raise CotError(f"unexpected '{name}' in node {node.name}")
+
+            kind, tok = self.next()
+            if tok == "{":
+                self.pos -= 1
+                child = self.child(node, name)
+                self.add_labels(labels, child)
+                self.parse_body(child)
+                self.expect(";")
+            elif tok == ";":
+                node.props[name] = []
+            elif tok == "=":
+                node.props[name] = self.parse_values()
+            else:
+                raise CotError(f"unexpected '{tok}' after {name}")
+
+        self.expect("}")
+
+    def parse_values(self):
+        values = []
+
+        while True:
+            kind, tok = self.next()
+            if kind == "string":
+                values.append(("string", ast.literal_eval(tok)))
+            elif kind == "ref":
+                values.append(("ref", tok[1:]))
+            elif tok == "<":
+                values.append(("cells", self.parse_cells()))
+            elif tok == "[":
+                data = ""
+                while self.peek()[1] != "]":
+                    data += self.next()[1]
+                self.next()
+                values.append(("bytes", bytes.fromhex(data)))
+            else:
+                raise CotError(f"unexpected '{tok}' in property value")
+
+            kind, tok = self.next()
+            if tok == ";":
+                return values
+            if tok != ",":
+                raise CotError(f"unexpected '{tok}' in property value")
+
+    def parse_cells(self):
+        cells = []
+
+        while True:
+            kind, tok = self.next()
+            if tok == ">":
+                return cells
+            if kind == "ref":
+                cells.append(("ref", tok[1:]))
+            elif tok == "(":
+                depth, expr = 1, "("
+                while depth > 0:
+                    kind, tok = self.next()
+                    depth += {"(": 1, ")": -1}.get(tok, 0)
+                    expr += tok
+                cells.append(eval_expr(expr))
+            elif kind == "name":
+                cells.append(eval_expr(tok))
+            else:
+                raise CotError(f"unexpected '{tok}' in cells")
+
+
+class CotImage:
+    def __init__(self, node, is_cert):
+        self.node = node
+        self.name = c_name(node.name)
+        self.is_cert = is_cert
+        self.img_id = None
+        self.root = False
+        self.parent = None
+        self.methods = []
+        self.auth_data = []
+
+
+def c_name(name):
+    return re.sub(r"[^A-Za-z0-9_]", "_", name)
+
+
+class CotCompiler:
+    def __init__(self, parser):
+        self.parser = parser
+        self.images = []
+        self.param_types = {}
+
+    def find_compatible(self, node, compatible):
+        value = node.props.get("compatible", [])
+        if ("string", compatible) in value:
+            yield node
+        for child in node.children.values():
+            yield from self.find_compatible(child, compatible)
+
+    def get_u32(self, node, prop, required=True):
+        value = node.props.get(prop)
+        if value is None:
+            if required:
+                raise CotError(f"{node.name}: missing property '{prop}'")
+            return None
+        if (len(value) != 1 or value[0][0] != "cells" or
+                len(value[0][1]) != 1 or
+                not isinstance(value[0][1][0], int)):
+            raise CotError(f"{node.name}: '{prop}' must be a single cell")
+        return value[0][1][0]
+
+    def get_ref(self, node, prop, required=True):
+        value = node.props.get(prop)
+        if value is None:
+            if required:
+                raise CotError(f"{node.name}: missing property '{prop}'")
+            return None
+        if (len(value) != 1 or value[0][0] != "cells" or
+                len(value[0][1]) != 1 or
+                not isinstance(value[0][1][0], tuple)):
+            raise CotError(f"{node.name}: '{prop}' must be a phandle")
+        return self.parser.lookup(value[0][1][0][1])
+
+    def get_param_type(self, node, prop, param_type, required=True):
+        """Get the parameter type descriptor for the OID of a referenced
+        node, creating it on first use."""
+        target = self.get_ref(node, prop, required)
+        if target is None:
+            return None
+
+        value = target.props.get("oid")
+        if value is None or len(value) != 1 or value[0][0] != "string":
+            raise CotError(f"{target.name}: missing string property 'oid'")
+
+        key = (param_type, value[0][1])
+        if key not in self.param_types:
+            name = c_name(target.name)
+            if name in self.param_types.values():
+                name += f"_{len(self.param_types)}"
+            self.param_types[key] = name
+        return key
+
+    def compile(self):
+        for compatible, is_cert in (("arm, cert-descs", True),
+                                    ("arm, img-descs", False)):
+            nodes = list(self.find_compatible(self.parser.root, compatible))
+            if len(nodes) != 1:
+                raise CotError(f"expected one node compatible with "
+                               f"'{compatible}', found {len(nodes)}")
+            for child in nodes[0].children.values():
+                self.images.append(CotImage(child, is_cert))
+
+        by_node = {img.node: img for img in self.images}
+        ids = {}
+
+        names = [img.name for img in self.images]
+        for name in names:
+            if names.count(name) > 1:
+                raise CotError(f"more than one image or certificate is "
+                               f"named {name}")
+
+        for img in self.images:
+            node = img.node
+            img.img_id = self.get_u32(node, "image-id")
+            if img.img_id in ids:
+                raise CotError(f"{node.name}: image-id {img.img_id} is "
+                               f"also used by {ids[img.img_id].node.name}")
+            ids[img.img_id] = img
+
+            img.root = img.is_cert and "root-certificate" in node.props
+
+            if not img.root:
+                parent = self.get_ref(node, "parent")
+                if parent not in by_node or not by_node[parent].is_cert:
+                    raise CotError(f"{node.name}: parent {parent.name} "
+                                   f"is not a certificate")
+                img.parent = by_node[parent]
+
+            if img.is_cert:
+                pk = (("AUTH_PARAM_PUB_KEY", None) if img.root else
+                      self.get_param_type(node, "signing-key",
+                                          "AUTH_PARAM_PUB_KEY"))
+                img.methods.append(("AUTH_METHOD_SIG", pk))
+            else:
+                img.methods.append(("AUTH_METHOD_HASH",
+                                    self.get_param_type(node, "hash",
+                                                        "AUTH_PARAM_HASH")))
+
+            nv_ctr = self.get_param_type(node, "antirollback-counter",
+                                         "AUTH_PARAM_NV_CTR", False)
+            if nv_ctr is not None:
+                img.methods.append(("AUTH_METHOD_NV_CTR", nv_ctr))
+
+        for img in self.images:
+            seen = set()
+            parent = img
+            while parent.parent is not None:
+                if parent in seen:
+                    raise CotError(f"{img.node.name}: parent loop")
+                seen.add(parent)
+                parent = parent.parent
+
+            if img.parent is not None:
+                # The parent certificate holds the key or hash of this image
+                param = img.methods[0][1]
+                if param not in img.parent.auth_data:
+                    img.parent.auth_data.append(param)
+
+    def depth(self, img):
+        depth = 0
+        while img.parent is not None:
+            depth += 1
+            img = img.parent
+        return depth
+
+    def generate(self, source):
+        out = []
+        emit = out.append
+
+        emit("/*\n"
+             f" * Generated from {source} by tools/cot_dt2c/cot_dt2c.py.\n"
+             " * Do not edit.\n"
+             " */\n\n"
+             "#include <stddef.h>\n\n"
+             "#include <common/tbbr/cot_def.h>\n"
+             "#include <drivers/auth/auth_mod.h>\n"
+             "#include <lib/cassert.h>\n\n"
+             "#include <platform_def.h>\n")
+
+        # Every certificate is signed, and the CoT has at least one root
+        # certificate, which is signed with the ROTPK.
+        emit("\nstatic auth_param_type_desc_t sig = AUTH_PARAM_TYPE_DESC(\n"
+             "\t\tAUTH_PARAM_SIG, 0);\n"
+             "static auth_param_type_desc_t sig_alg = AUTH_PARAM_TYPE_DESC(\n"
+             "\t\tAUTH_PARAM_SIG_ALG, 0);\n"
+             "static auth_param_type_desc_t raw_data = AUTH_PARAM_TYPE_DESC(\n"
+             "\t\tAUTH_PARAM_RAW_DATA, 0);\n"
+             "static auth_param_type_desc_t subject_pk = AUTH_PARAM_TYPE_DESC(\n"
+             "\t\tAUTH_PARAM_PUB_KEY, 0);\n")
+
+        for (param_type, oid), name in self.param_types.items():
+            emit(f"static auth_param_type_desc_t {name}_param = "
+                 "AUTH_PARAM_TYPE_DESC(\n"
+                 f"\t\t{param_type}, \"{oid}\");\n")
+
+        images = sorted(self.images, key=self.depth)
+
+        emit("\n")
+        for img in images:
+            for param in img.auth_data:
+                size = ("PK_DER_LEN" if param[0] == "AUTH_PARAM_PUB_KEY"
+                        else "HASH_DER_LEN")
+                emit(f"static unsigned char {img.name}_"
+                     f"{self.param_types[param]}_buf[{size}];\n")
+
+        for img in images:
+            emit(self.generate_image(img))
+
+        emit("\nstatic const auth_img_desc_t *const "
+             "cot_desc[MAX_NUMBER_IDS] = {\n")
+        for img in sorted(self.images, key=lambda i: i.img_id):
+            emit(f"\t[{img.img_id}] = &{img.name},\n")
+        emit("};\n\n")
+        emit("/* Register the CoT in the authentication module */\n"
+             "REGISTER_COT(cot_desc);\n")
+
+        return "".join(out)
+
+    def param_ref(self, param):
+        if param[1] is None:
+            return "&subject_pk"
+        return f"&{self.param_types[param]}_param"
+
+    def generate_image(self, img):
+        out = [f"\n/* {img.node.name} */\n"]
+        emit = out.append
+
+        if len(img.auth_data) > 0:
+            emit(f"CASSERT({len(img.auth_data)} <= COT_MAX_VERIFIED_PARAMS,\n"
+                 f"\tassert_{img.name}_verified_params);\n\n")
+
+        emit(f"static const auth_img_desc_t {img.name} = {{\n"
+             f"\t.img_id = {img.img_id},\n"
+             f"\t.img_type = {'IMG_CERT' if img.is_cert else 'IMG_RAW'},\n"
+             "\t.parent = "
+             f"{'&' + img.parent.name if img.parent else 'NULL'},\n"
+             "\t.img_auth_methods = (const auth_method_desc_t[AUTH_METHOD_NUM])"
+             " {\n")
+
+        for i, (method, param) in enumerate(img.methods):
+            emit(f"\t\t[{i}] = {{\n\t\t\t.type = {method},\n")
+            if method == "AUTH_METHOD_SIG":
+                emit("\t\t\t.param.sig = {\n"
+                     f"\t\t\t\t.pk = {self.param_ref(param)},\n"
+                     "\t\t\t\t.sig = &sig,\n"
+                     "\t\t\t\t.alg = &sig_alg,\n"
+                     "\t\t\t\t.data = &raw_data\n"
+                     "\t\t\t}\n")
+            elif method == "AUTH_METHOD_HASH":
+                emit("\t\t\t.param.hash = {\n"
+                     "\t\t\t\t.data = &raw_data,\n"
+                     f"\t\t\t\t.hash = {self.param_ref(param)}\n"
+                     "\t\t\t}\n")
+            else:
+                emit("\t\t\t.param.nv_ctr = {\n"
+                     f"\t\t\t\t.cert_nv_ctr = {self.param_ref(param)},\n"
+                     f"\t\t\t\t.plat_nv_ctr = {self.param_ref(param)}\n"
+                     "\t\t\t}\n")
+            emit("\t\t},\n")
+        emit("\t},\n")
+
+        if len(img.auth_data) > 0:
+            emit("\t.authenticated_data = (const auth_param_desc_t"
+                 "[COT_MAX_VERIFIED_PARAMS]) {\n")
+            for i, param in enumerate(img.auth_data):
+                size = ("PK_DER_LEN" if param[0] == "AUTH_PARAM_PUB_KEY"
+                        else "HASH_DER_LEN")
+                emit(f"\t\t[{i}] = {{\n"
+                     f"\t\t\t.type_desc = {self.param_ref(param)},\n"
+                     "\t\t\t.data = {\n"
+                     f"\t\t\t\t.ptr = (void *){img.name}_"
+                     f"{self.param_types[param]}_buf,\n"
+                     f"\t\t\t\t.len = (unsigned int){size}\n"
+                     "\t\t\t}\n"
+                     "\t\t},\n")
+            emit("\t},\n")
+
+        emit("};\n")
+
+        return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a chain of trust described in device tree "
+                    "into C tables.")
+    parser.add_argument("dts", help="preprocessed CoT DTS file")
+    parser.add_argument("output", help="C file to generate")
+    parser.add_argument("--source",
+                        help="name of the CoT source file, for the header")
+    args = parser.parse_args()
+
+    try:
+        with open(args.dts) as f:
+            dts = DtsParser(f.read())
+        dts.parse()
+
+        cot = CotCompiler(dts)
+        cot.compile()
+        text = cot.generate(args.source or args.dts)
+    except (CotError, OSError) as e:
+        print(f"{args.dts}: error: {e}", file=sys.stderr)
+        return 1
+
+    with open(args.output, "w") as f:
+        f.write(text)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -604,14 +604,102 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 		log_errx("Failed to set file position");
 
 	pad_size = toc_entry->offset_address - entry_offset;
-	while (pad_size--)
-		fputc(0x0, fp);
+	if (pad_size != 0) {
+		char *pad = xzalloc(pad_size, "failed to allocate padding");
+
+		xfwrite(pad, pad_size, fp, filename);
+		free(pad);
+	}
 
 	free(buf);
 	fclose(fp);
 	return 0;
 }
 
+static uint64_t get_file_size(const char *filename)
+{
+	struct BLD_PLAT_STAT st;
+	FILE *fp;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	if (fstat(fileno(fp), &st) == -1)
+		log_errx("fstat %s", filename);
+
+	fclose(fp);
+	return st.st_size;
+}
+
+/*
+ * Update an existing FIP file without repacking it. This is only possible
+ * when every image to pack replaces an image of the same size whose offset
+ * honours the requested alignment, so that no ToC entry moves. Only the ToC
+ * header and the payloads that changed are then rewritten.
+ *
+ * Returns 0 on success, or -1 if the FIP file needs to be repacked, in which
+ * case nothing has been modified.
+ */
+static int update_fip_in_place(const char *filename,
+    const fip_toc_header_t *toc_header, unsigned long align)
+{
+	image_desc_t *desc;
+	FILE *fp;
+
+	if ((get_file_size(filename) & (align - 1)) != 0)
+		return -1;
+
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image = desc->image;
+
+		if (image == NULL) {
+			if (desc->action == DO_PACK)
+				return -1;
+			continue;
+		}
+		/* Empty images are dropped when the FIP is repacked. */
+		if (image->toc_e.size == 0 ||
+		    (image->toc_e.offset_address & (align - 1)) != 0)
+			return -1;
+		if (desc->action == DO_PACK &&
+		    get_file_size(desc->action_arg) != image->toc_e.size)
+			return -1;
+	}
+
+	fp = fopen(filename, "r+b");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	xfwrite((void *)toc_header, sizeof(*toc_header), fp, filename);
+
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image;
+
+		if (desc->action != DO_PACK)
+			continue;
+
+		image = read_image_from_file(&desc->uuid, desc->action_arg);
+		image->toc_e = desc->image->toc_e;
+		if (memcmp(image->buffer, desc->image->buffer,
+		    image->toc_e.size) != 0) {
+			if (verbose)
+				log_dbgx("Rewriting %s in place with %s",
+				    desc->cmdline_name, desc->action_arg);
+			if (fseek(fp, image->toc_e.offset_address, SEEK_SET))
+				log_errx("Failed to set file position");
+			xfwrite(image->buffer, image->toc_e.size, fp, filename);
+		}
+
+		free(desc->image->buffer);
+		free(desc->image);
+		desc->image = image;
+	}
+
+	fclose(fp);
+	return 0;
+}
+
 /*
  * This function is shared between the create and update subcommands.
  * The difference between the two subcommands is that when the FIP file
@@ -638,6 +726,7 @@ static void update_fip(void)
 				    desc->cmdline_name,
 				    desc->action_arg);
 			}
+			free(desc->image->buffer);
 			free(desc->image);
 			desc->image = image;
 		} else {
@@ -805,6 +894,7 @@ static int update_cmd(int argc, char *argv[])
 	unsigned long long toc_flags = 0;
 	unsigned long align = 1;
 	int pflag = 0;
+	int parsed = 0;
 
 	if (argc < 2)
 		update_usage(EXIT_FAILURE);
@@ -878,13 +968,19 @@ static int update_cmd(int argc, char *argv[])
 	if (outfile[0] == '\0')
 		snprintf(outfile, sizeof(outfile), "%s", argv[0]);
 
-	if (access(argv[0], F_OK) == 0)
+	if (access(argv[0], F_OK) == 0) {
 		parse_fip(argv[0], &toc_header);
+		parsed = 1;
+	}
 
 	if (pflag)
 		toc_header.flags &= ~(0xffffULL << 32);
 	toc_flags = (toc_header.flags |= toc_flags);
 
+	if (parsed && strcmp(outfile, argv[0]) == 0 &&
+	    update_fip_in_place(outfile, &toc_header, align) == 0)
+		return 0;
+
 	update_fip();
 
 	pack_images(outfile, toc_flags, align);
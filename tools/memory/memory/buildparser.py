@@ -7,6 +7,7 @@
 import re
 from pathlib import Path
 
+from memory.cachelayout import TfaCacheLayoutParser
 from memory.elfparser import TfaElfParser
 from memory.mapparser import TfaMapParser
 
@@ -16,6 +17,7 @@ class TfaBuildParser:
 
     def __init__(self, path: Path, map_backend=False):
         self._modules = dict()
+        self._files = dict()
         self._path = path
         self.map_backend = map_backend
         self._parse_modules()
@@ -39,6 +41,7 @@ class TfaBuildParser:
             module_name = file.name.split("/")[-1].split(".")[0]
             with open(file, io_perms) as f:
                 self._modules[module_name] = backend(f)
+            self._files[module_name] = file
 
         if not len(self._modules):
             raise FileNotFoundError(
@@ -82,6 +85,20 @@ class TfaBuildParser:
             for k, v in self._modules.items()
         }
 
+    def get_cache_layouts(self, line_size: int) -> dict:
+        """Returns the cache line layout of the per-CPU data of each module
+        built with debug information."""
+        assert not self.map_backend, "Cache layouts require ELF images!"
+        layouts = {}
+        for k, file in self._files.items():
+            with open(file, "rb") as f:
+                mod_layouts = TfaCacheLayoutParser(
+                    f, line_size
+                ).get_cache_layouts()
+            if len(mod_layouts):
+                layouts[k] = mod_layouts
+        return layouts
+
     @property
     def module_names(self):
         """Returns sorted list of module names."""
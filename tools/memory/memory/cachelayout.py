@@ -0,0 +1,188 @@
+#
+# Copyright (c) 2024, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+from dataclasses import dataclass
+from typing import BinaryIO
+
+from elftools.elf.elffile import ELFFile
+
+# Per-CPU and per-power-domain objects whose layout matters for cross-core
+# coherence traffic, indexed by symbol name. Each entry gives the structure
+# type of an element and the members that are written by CPUs other than the
+# owner of the element.
+TRACKED_OBJECTS = {
+    "percpu_data": ("cpu_data", ["psci_svc_cpu_data"]),
+    "psci_cpu_pd_nodes": ("cpu_pwr_domain_node", []),
+    "psci_non_cpu_pd_nodes": ("non_cpu_pwr_domain_node", []),
+    "psci_cpu_stat": ("psci_pcpu_stat", []),
+}
+
+
+@dataclass(frozen=True)
+class TfaStructMember:
+    name: str
+    offset: int
+    size: int
+    remote: bool
+
+
+@dataclass(frozen=True)
+class TfaCacheLayout:
+    symbol: str
+    address: int
+    size: int
+    type_name: str
+    type_size: int
+    members: list
+    risks: list
+
+
+class TfaCacheLayoutParser:
+    """A class for checking the cache line layout of per-CPU data in an ELF
+    file built for TF-A.
+
+    The structure layouts are read from the DWARF debug information, so the
+    image must have been built with debug information (DEBUG=1).
+    """
+
+    def __init__(self, elf_file: BinaryIO, line_size: int = 64):
+        self.line_size = line_size
+
+        elf = ELFFile(elf_file)
+
+        self._symbols = {
+            sym.name: (sym.entry["st_value"], sym.entry["st_size"])
+            for sym in elf.get_section_by_name(".symtab").iter_symbols()
+            if sym.name in TRACKED_OBJECTS
+        }
+
+        self._structs = (
+            self._get_struct_layouts(elf.get_dwarf_info())
+            if elf.has_dwarf_info()
+            else {}
+        )
+
+    @staticmethod
+    def _get_member_offset(die) -> int:
+        loc = die.attributes["DW_AT_data_member_location"].value
+
+        # DWARF 2 encodes the offset as a DW_OP_plus_uconst expression.
+        return loc if isinstance(loc, int) else loc[-1]
+
+    @staticmethod
+    def _get_type_size(die) -> int:
+        """Get the size of the type of a DIE, following typedefs, qualifiers
+        and arrays."""
+        die = die.get_DIE_from_attribute("DW_AT_type")
+
+        if "DW_AT_byte_size" in die.attributes:
+            return die.attributes["DW_AT_byte_size"].value
+
+        if die.tag == "DW_TAG_array_type":
+            count = 1
+            for sub in die.iter_children():
+                if "DW_AT_count" in sub.attributes:
+                    count *= sub.attributes["DW_AT_count"].value
+                elif "DW_AT_upper_bound" in sub.attributes:
+                    count *= sub.attributes["DW_AT_upper_bound"].value + 1
+            return count * TfaCacheLayoutParser._get_type_size(die)
+
+        if "DW_AT_type" in die.attributes:
+            return TfaCacheLayoutParser._get_type_size(die)
+
+        return 0
+
+    def _get_struct_layouts(self, dwarf) -> dict:
+        """Get the size and members of the tracked structure types."""
+        wanted = {v[0]: v[1] for v in TRACKED_OBJECTS.values()}
+        structs = {}
+
+        for cu in dwarf.iter_CUs():
+            for die in cu.iter_DIEs():
+                if die.tag != "DW_TAG_structure_type":
+                    continue
+                if "DW_AT_name" not in die.attributes:
+                    continue
+
+                name = die.attributes["DW_AT_name"].value.decode()
+                if name not in wanted or name in structs:
+                    continue
+                if "DW_AT_byte_size" not in die.attributes:
+                    continue
+
+                members = [
+                    TfaStructMember(
+                        m.attributes["DW_AT_name"].value.decode(),
+                        self._get_member_offset(m),
+                        self._get_type_size(m),
+                        m.attributes["DW_AT_name"].value.decode()
+                        in wanted[name],
+                    )
+                    for m in die.iter_children()
+                    if m.tag == "DW_TAG_member"
+                    and "DW_AT_name" in m.attributes
+                ]
+
+                structs[name] = (
+                    die.attributes["DW_AT_byte_size"].value,
+                    members,
+                )
+
+        return structs
+
+    def _lines(self, member: TfaStructMember) -> set:
+        """Get the cache lines of an element occupied by a member."""
+        first = member.offset // self.line_size
+        last = (member.offset + max(member.size, 1) - 1) // self.line_size
+        return set(range(first, last + 1))
+
+    def _get_risks(self, address: int, type_size: int, members: list):
+        """List the reasons why elements may share cache lines."""
+        risks = []
+
+        if address % self.line_size:
+            risks.append("array is not aligned to a cache line")
+
+        if type_size % self.line_size:
+            risks.append("adjacent elements share cache lines")
+
+        owned = [m for m in members if not m.remote]
+        for remote in filter(lambda m: m.remote, members):
+            shared = [
+                m.name for m in owned if self._lines(m) & self._lines(remote)
+            ]
+            if shared:
+                risks.append(
+                    f"remote '{remote.name}' shares a line with "
+                    + ", ".join(f"'{s}'" for s in shared)
+                )
+
+        return risks
+
+    def get_cache_layouts(self) -> list:
+        """Returns the layout of each tracked object found in the image."""
+        layouts = []
+
+        for symbol, (type_name, _) in TRACKED_OBJECTS.items():
+            if symbol not in self._symbols or type_name not in self._structs:
+                continue
+
+            address, size = self._symbols[symbol]
+            type_size, members = self._structs[type_name]
+
+            layouts.append(
+                TfaCacheLayout(
+                    symbol,
+                    address,
+                    size,
+                    type_name,
+                    type_size,
+                    members,
+                    self._get_risks(address, type_size, members),
+                )
+            )
+
+        return layouts
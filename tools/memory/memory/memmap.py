@@ -66,6 +66,18 @@ from memory.printer import TfaPrettyPrinter
     default=False,
     help="Display numbers in decimal base.",
 )
+@click.option(
+    "-c",
+    "--cache-layout",
+    is_flag=True,
+    help="Report the cache line layout of the per-CPU data.",
+)
+@click.option(
+    "--line-size",
+    default=64,
+    show_default=True,
+    help="Cache line size (CACHE_WRITEBACK_GRANULE) used by --cache-layout.",
+)
 @click.option(
     "--no-elf-images",
     is_flag=True,
@@ -81,6 +93,8 @@ def main(
     depth: int,
     width: int,
     d: bool,
+    cache_layout: bool,
+    line_size: int,
     no_elf_images: bool,
 ):
     build_path = root if root else Path("build/", platform, build_type)
@@ -89,7 +103,7 @@ def main(
     parser = TfaBuildParser(build_path, map_backend=no_elf_images)
     printer = TfaPrettyPrinter(columns=width, as_decimal=d)
 
-    if footprint or not (tree or symbols):
+    if footprint or not (tree or symbols or cache_layout):
         printer.print_footprint(parser.get_mem_usage_dict())
 
     if tree:
@@ -106,6 +120,11 @@ def main(
             parser.filter_symbols(parser.symbols, expr), parser.module_names
         )
 
+    if cache_layout:
+        printer.print_cache_layout(
+            parser.get_cache_layouts(line_size), line_size
+        )
+
 
 if __name__ == "__main__":
     main()
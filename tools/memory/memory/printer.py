@@ -161,3 +161,30 @@ class TfaPrettyPrinter:
                     )
                 )
         print("\n".join(self._tree), "\n")
+
+    def print_cache_layout(self, layouts: dict, line_size: int):
+        for mod in sorted(layouts):
+            for obj in layouts[mod]:
+                count = obj.size // obj.type_size if obj.type_size else 0
+                table = PrettyTable(
+                    title=f"{mod.upper()}: {obj.symbol} "
+                    f"(struct {obj.type_name}, {count} x "
+                    f"{obj.type_size} bytes at {obj.address:#x})",
+                    field_names=["Member", "Offset", "Size", "Line", "Remote"],
+                )
+                table.align["Member"] = "l"
+
+                for m in obj.members:
+                    table.add_row(
+                        [
+                            m.name,
+                            *self.format_args(m.offset, m.size, width=6),
+                            m.offset // line_size,
+                            "yes" if m.remote else "",
+                        ]
+                    )
+                print(table)
+
+                for risk in obj.risks:
+                    print(f"WARNING: {obj.symbol}: {risk}")
+                print()